@@ -3,12 +3,27 @@
 #include <float.h>
 #include <obs-module.h>
 #include <obs-frontend-api.h>
+#include <util/platform.h>
+#include <util/threading.h>
 
 #define METER_TYPE_MAGNITUDE 0
 #define METER_TYPE_PEAK_SAMPLE 1
 #define METER_TYPE_PEAK_TRUE 2
 #define METER_TYPE_INPUT_PEAK_SAMPLE 3
 #define METER_TYPE_INPUT_PEAK_TRUE 4
+#define METER_TYPE_BAND 5
+
+#define BAND_STEP 10
+
+#define CHANNEL_MODE_SINGLE 0
+#define CHANNEL_MODE_MAX 1
+#define CHANNEL_MODE_MEAN 2
+
+#define RMS_WINDOW_MAX 5000
+#define RMS_SAMPLES 512
+
+#define RESOLVE_BACKOFF_MIN 100000000ULL
+#define RESOLVE_BACKOFF_MAX 2000000000ULL
 
 #define VALUE_ACTION_TRANSFORM 0
 #define VALUE_ACTION_SETTING 1
@@ -39,23 +54,114 @@
 #define TRANSFORM_CROP_HORIZONTAL 12
 #define TRANSFORM_CROP_VERTICAL 13
 
+union audio_move_transform_value {
+	struct vec2 vec;
+	float rot;
+	struct obs_sceneitem_crop crop;
+};
+
+/* how a transform is written: the components of the value it sets, and the
+ * getter for the components it leaves alone, NULL when it sets them all */
+struct audio_move_transform_setter {
+	void (*get)(obs_sceneitem_t *item,
+		    union audio_move_transform_value *value);
+	void (*set)(obs_sceneitem_t *item,
+		    const union audio_move_transform_value *value);
+	size_t offset[2];
+	size_t components;
+	bool is_int;
+};
+
+/* latest levels, published by the audio thread, with the level of the
+ * callback before to interpolate between */
+struct audio_move_levels {
+	float channels[MAX_AUDIO_CHANNELS];
+	double value;
+	uint64_t timestamp;
+	double prev_value;
+	uint64_t prev_timestamp;
+};
+
+/* the history of each channel is a ring of the last samples, the mix of the
+ * channels goes into the first one */
+struct audio_move_band {
+	struct move_fft fft;
+	float history[MAX_AUDIO_CHANNELS][MOVE_FFT_SIZE];
+	size_t pos;
+};
+
 struct audio_move_info {
 	obs_source_t *source;
-	double easing;
+	double attack;
+	double release;
 	double audio_value;
+	/* triple buffer of the latest levels, the audio thread owns the back
+	 * slot and the tick the front slot, they trade slots through the
+	 * middle index, which is marked fresh after a write */
+	struct audio_move_levels levels[3];
+	volatile long levels_middle;
+	long levels_back;
+	long levels_front;
+	double levels_value;
+	uint64_t levels_timestamp;
+
+	long long channel_mode;
+	long long channel;
+	size_t channels;
+
+	/* levels of the last callbacks within the rms window, audio thread
+	 * only */
+	uint64_t rms_window;
+	double rms_square[RMS_SAMPLES];
+	uint64_t rms_time[RMS_SAMPLES];
+	size_t rms_start;
+	size_t rms_count;
+	double rms_sum;
+
+	bool direct_capture;
+	obs_source_t *capture_source;
+
+	/* band analysis, only allocated while the meter type is band */
+	struct audio_move_band *band;
+	float band_low;
+	float band_high;
+
 	double base_value;
 	double factor;
 	long long action;
 	long long threshold_action;
 	double threshold;
+	double threshold_under;
+	uint64_t threshold_hold;
+	uint64_t toggle_time;
+	long long toggles;
 
 	obs_sceneitem_t *sceneitem;
 	obs_weak_source_t *target_source;
 	char *setting_name;
 
+	/* a missing target is looked up again after sources were created,
+	 * renamed or loaded or an item was added to the scene */
+	volatile bool resolve_pending;
+	uint64_t resolve_next;
+	uint64_t resolve_backoff;
+	obs_weak_source_t *resolve_scene;
+
 	obs_volmeter_t *volmeter;
 	long long meter_type;
 	long long transform;
+	const struct audio_move_transform_setter *transform_setter;
+
+	/* last value written to the target, smaller changes are not written */
+	double last_value;
+	bool last_value_set;
+	double min_change;
+
+	/* type of the target setting, looked up by the tick once after every
+	 * update, and the data the tick writes to it */
+	enum obs_data_number_type setting_num_type;
+	bool setting_lookup_failed;
+	obs_data_t *setting_data;
 };
 
 static const char *audio_move_get_name(void *type_data)
@@ -64,25 +170,463 @@ static const char *audio_move_get_name(void *type_data)
 	return obs_module_text("AudioMoveFilter");
 }
 
+#define LEVELS_FRESH 4
+
+/* the exchanges order the copies, so neither thread ever waits */
+static void audio_move_levels_write(struct audio_move_info *audio_move,
+				    const struct audio_move_levels *levels)
+{
+	memcpy(&audio_move->levels[audio_move->levels_back], levels,
+	       sizeof(struct audio_move_levels));
+	audio_move->levels_back =
+		os_atomic_set_long(&audio_move->levels_middle,
+				   audio_move->levels_back | LEVELS_FRESH) &
+		~LEVELS_FRESH;
+}
+
+static void audio_move_levels_read(struct audio_move_info *audio_move,
+				   struct audio_move_levels *levels)
+{
+	if (os_atomic_load_long(&audio_move->levels_middle) & LEVELS_FRESH)
+		audio_move->levels_front =
+			os_atomic_set_long(&audio_move->levels_middle,
+					   audio_move->levels_front) &
+			~LEVELS_FRESH;
+	memcpy(levels, &audio_move->levels[audio_move->levels_front],
+	       sizeof(struct audio_move_levels));
+}
+
+static size_t audio_move_channels(struct audio_move_info *audio_move)
+{
+	const size_t channels = audio_move->channels;
+	if (channels < 1 || channels > MAX_AUDIO_CHANNELS)
+		return MAX_AUDIO_CHANNELS;
+	return channels;
+}
+
+/* combines the linear levels of the channels into one */
+static double audio_move_channel_level(struct audio_move_info *audio_move,
+				       const float level[MAX_AUDIO_CHANNELS])
+{
+	const size_t channels = audio_move_channels(audio_move);
+	if (audio_move->channel_mode == CHANNEL_MODE_MAX) {
+		double v = 0.0;
+		for (size_t i = 0; i < channels; i++) {
+			if (level[i] > v)
+				v = level[i];
+		}
+		return v;
+	}
+	if (audio_move->channel_mode == CHANNEL_MODE_MEAN) {
+		double v = 0.0;
+		for (size_t i = 0; i < channels; i++)
+			v += level[i];
+		return v / (double)channels;
+	}
+	long long channel = audio_move->channel - 1;
+	if (channel < 0 || channel >= (long long)channels)
+		channel = 0;
+	return level[channel];
+}
+
+/* adds a level to the rms window and returns the rms over the window, the
+ * running sum keeps this constant time per callback */
+static double audio_move_rms(struct audio_move_info *audio_move, double v,
+			     uint64_t now)
+{
+	while (audio_move->rms_count &&
+	       (audio_move->rms_count == RMS_SAMPLES ||
+		now - audio_move->rms_time[audio_move->rms_start] >
+			audio_move->rms_window)) {
+		audio_move->rms_sum -=
+			audio_move->rms_square[audio_move->rms_start];
+		audio_move->rms_start = (audio_move->rms_start + 1) %
+					RMS_SAMPLES;
+		audio_move->rms_count--;
+	}
+	if (!audio_move->rms_count)
+		audio_move->rms_sum = 0.0;
+	const size_t end =
+		(audio_move->rms_start + audio_move->rms_count) % RMS_SAMPLES;
+	audio_move->rms_square[end] = v * v;
+	audio_move->rms_time[end] = now;
+	audio_move->rms_count++;
+	audio_move->rms_sum += v * v;
+	if (audio_move->rms_sum < 0.0)
+		audio_move->rms_sum = 0.0;
+	return sqrt(audio_move->rms_sum / (double)audio_move->rms_count);
+}
+
+static void audio_move_levels_updated(struct audio_move_info *audio_move,
+				      struct audio_move_levels *levels,
+				      double v)
+{
+	levels->timestamp = os_gettime_ns();
+	if (audio_move->rms_window)
+		v = audio_move_rms(audio_move, v, levels->timestamp);
+	levels->value = v;
+	levels->prev_value = audio_move->levels_value;
+	levels->prev_timestamp = audio_move->levels_timestamp;
+	audio_move->levels_value = levels->value;
+	audio_move->levels_timestamp = levels->timestamp;
+	audio_move_levels_write(audio_move, levels);
+}
+
 void audio_move_volmeter_updated(void *data,
 				 const float magnitude[MAX_AUDIO_CHANNELS],
 				 const float peak[MAX_AUDIO_CHANNELS],
 				 const float input_peak[MAX_AUDIO_CHANNELS])
 {
 	struct audio_move_info *audio_move = data;
-	float v = 0.0f;
+	const float *db = NULL;
 	if (audio_move->meter_type == METER_TYPE_MAGNITUDE) {
-		v = magnitude[0];
+		db = magnitude;
 	} else if (audio_move->meter_type == METER_TYPE_INPUT_PEAK_SAMPLE ||
 		   audio_move->meter_type == METER_TYPE_INPUT_PEAK_TRUE) {
-		v = input_peak[0];
+		db = input_peak;
 	} else if (audio_move->meter_type == METER_TYPE_PEAK_SAMPLE ||
 		   audio_move->meter_type == METER_TYPE_PEAK_TRUE) {
-		v = peak[0];
+		db = peak;
+	}
+	struct audio_move_levels levels = {0};
+	const size_t channels = audio_move_channels(audio_move);
+	for (size_t i = 0; db && i < channels; i++)
+		levels.channels[i] = obs_db_to_mul(db[i]);
+	audio_move_levels_updated(
+		audio_move, &levels,
+		audio_move_channel_level(audio_move, levels.channels));
+}
+
+/* the loudest channel needs the band level of every channel, the other modes
+ * analyse the selected channel or the mix of all channels once */
+static void audio_move_band_levels(struct audio_move_info *audio_move,
+				   const struct audio_data *audio_data,
+				   size_t channels,
+				   float level[MAX_AUDIO_CHANNELS])
+{
+	struct audio_move_band *band = audio_move->band;
+	const size_t pos = band->pos;
+	band->pos = (pos + audio_data->frames) % MOVE_FFT_SIZE;
+	if (audio_move->channel_mode == CHANNEL_MODE_MAX) {
+		for (size_t c = 0; c < channels; c++) {
+			const float *samples =
+				(const float *)audio_data->data[c];
+			if (!samples)
+				continue;
+			float *history = band->history[c];
+			for (uint32_t i = 0; i < audio_data->frames; i++)
+				history[(pos + i) % MOVE_FFT_SIZE] = samples[i];
+			level[c] = move_fft_band_level(&band->fft, history,
+						       band->pos,
+						       audio_move->band_low,
+						       audio_move->band_high);
+		}
+		return;
+	}
+
+	size_t first = 0;
+	size_t count = channels;
+	if (audio_move->channel_mode == CHANNEL_MODE_SINGLE) {
+		const long long channel = audio_move->channel - 1;
+		if (channel > 0 && channel < (long long)channels)
+			first = (size_t)channel;
+		count = 1;
+	}
+	for (size_t c = first; c < first + count; c++) {
+		if (!audio_data->data[c]) {
+			count = c - first;
+			break;
+		}
+	}
+	if (!count)
+		return;
+	const float mix = 1.0f / (float)count;
+	float *history = band->history[0];
+	for (uint32_t i = 0; i < audio_data->frames; i++) {
+		float sample = 0.0f;
+		for (size_t c = first; c < first + count; c++)
+			sample += ((const float *)audio_data->data[c])[i];
+		history[(pos + i) % MOVE_FFT_SIZE] = sample * mix;
+	}
+	const float v = move_fft_band_level(&band->fft, history, band->pos,
+					    audio_move->band_low,
+					    audio_move->band_high);
+	for (size_t c = 0; c < channels; c++)
+		level[c] = v;
+}
+
+/* measures the levels straight from the audio of the parent, without the
+ * dB conversions and true peak work of a volmeter */
+static void audio_move_audio_captured(void *data, obs_source_t *source,
+				      const struct audio_data *audio_data,
+				      bool muted)
+{
+	struct audio_move_info *audio_move = data;
+	const long long meter_type = audio_move->meter_type;
+	float mul = 1.0f;
+	if (meter_type != METER_TYPE_INPUT_PEAK_SAMPLE)
+		mul = muted ? 0.0f : obs_source_get_volume(source);
+
+	struct audio_move_levels levels = {0};
+	const size_t channels = audio_move_channels(audio_move);
+	if (meter_type == METER_TYPE_BAND) {
+		audio_move_band_levels(audio_move, audio_data, channels,
+				       levels.channels);
+		for (size_t i = 0; i < channels; i++)
+			levels.channels[i] *= mul;
+	} else {
+		for (size_t i = 0; i < channels; i++) {
+			if (!audio_data->data[i])
+				continue;
+			float rms;
+			float peak;
+			move_audio_level((const float *)audio_data->data[i],
+					 audio_data->frames, &rms, &peak);
+			levels.channels[i] =
+				(meter_type == METER_TYPE_MAGNITUDE ? rms
+								    : peak) *
+				mul;
+		}
 	}
-	v = obs_db_to_mul(v);
-	audio_move->audio_value = audio_move->easing * audio_move->audio_value +
-				  (1.0 - audio_move->easing) * v;
+	audio_move_levels_updated(
+		audio_move, &levels,
+		audio_move_channel_level(audio_move, levels.channels));
+}
+
+static bool audio_move_direct_capture(long long meter_type)
+{
+	return meter_type == METER_TYPE_MAGNITUDE ||
+	       meter_type == METER_TYPE_PEAK_SAMPLE ||
+	       meter_type == METER_TYPE_INPUT_PEAK_SAMPLE;
+}
+
+/* switches between the volmeter and the direct capture callback */
+static void audio_move_attach(struct audio_move_info *audio_move,
+			      obs_source_t *parent)
+{
+	const bool direct =
+		audio_move->meter_type == METER_TYPE_BAND ||
+		(audio_move->direct_capture &&
+		 audio_move_direct_capture(audio_move->meter_type));
+	obs_source_t *capture_source = direct ? parent : NULL;
+	if (capture_source != audio_move->capture_source) {
+		if (audio_move->capture_source)
+			obs_source_remove_audio_capture_callback(
+				audio_move->capture_source,
+				audio_move_audio_captured, audio_move);
+		audio_move->capture_source = capture_source;
+		if (capture_source) {
+			obs_volmeter_detach_source(audio_move->volmeter);
+			obs_source_add_audio_capture_callback(
+				capture_source, audio_move_audio_captured,
+				audio_move);
+		}
+	}
+	if (!capture_source && parent)
+		obs_volmeter_attach_source(audio_move->volmeter, parent);
+}
+
+static void audio_move_get_pos(obs_sceneitem_t *item,
+			       union audio_move_transform_value *value)
+{
+	obs_sceneitem_get_pos(item, &value->vec);
+}
+
+static void audio_move_set_pos(obs_sceneitem_t *item,
+			       const union audio_move_transform_value *value)
+{
+	obs_sceneitem_set_pos(item, &value->vec);
+}
+
+static void audio_move_set_rot(obs_sceneitem_t *item,
+			       const union audio_move_transform_value *value)
+{
+	obs_sceneitem_set_rot(item, value->rot);
+}
+
+static void audio_move_get_scale(obs_sceneitem_t *item,
+				 union audio_move_transform_value *value)
+{
+	obs_sceneitem_get_scale(item, &value->vec);
+}
+
+static void audio_move_set_scale(obs_sceneitem_t *item,
+				 const union audio_move_transform_value *value)
+{
+	obs_sceneitem_set_scale(item, &value->vec);
+}
+
+static void audio_move_get_bounds(obs_sceneitem_t *item,
+				  union audio_move_transform_value *value)
+{
+	obs_sceneitem_get_bounds(item, &value->vec);
+}
+
+static void audio_move_set_bounds(obs_sceneitem_t *item,
+				  const union audio_move_transform_value *value)
+{
+	obs_sceneitem_set_bounds(item, &value->vec);
+}
+
+static void audio_move_get_crop(obs_sceneitem_t *item,
+				union audio_move_transform_value *value)
+{
+	obs_sceneitem_get_crop(item, &value->crop);
+}
+
+static void audio_move_set_crop(obs_sceneitem_t *item,
+				const union audio_move_transform_value *value)
+{
+	obs_sceneitem_set_crop(item, &value->crop);
+}
+
+#define VEC_X offsetof(struct vec2, x)
+#define VEC_Y offsetof(struct vec2, y)
+#define CROP(side) offsetof(struct obs_sceneitem_crop, side)
+
+/* TRANSFORM_SCALE and TRANSFORM_SCALE_X share a value, it scales both */
+static const struct audio_move_transform_setter
+	audio_move_transform_setters[] = {
+	[TRANSFORM_POS_X] = {audio_move_get_pos, audio_move_set_pos, {VEC_X}, 1,
+			     false},
+	[TRANSFORM_POS_Y] = {audio_move_get_pos, audio_move_set_pos, {VEC_Y}, 1,
+			     false},
+	[TRANSFORM_ROT] = {NULL, audio_move_set_rot, {0}, 1, false},
+	[TRANSFORM_SCALE] = {NULL, audio_move_set_scale, {VEC_X, VEC_Y}, 2,
+			     false},
+	[TRANSFORM_SCALE_Y] = {audio_move_get_scale, audio_move_set_scale,
+			       {VEC_Y}, 1, false},
+	[TRANSFORM_BOUNDS_X] = {audio_move_get_bounds, audio_move_set_bounds,
+				{VEC_X}, 1, false},
+	[TRANSFORM_BOUNDS_Y] = {audio_move_get_bounds, audio_move_set_bounds,
+				{VEC_Y}, 1, false},
+	[TRANSFORM_CROP_LEFT] = {audio_move_get_crop, audio_move_set_crop,
+				 {CROP(left)}, 1, true},
+	[TRANSFORM_CROP_TOP] = {audio_move_get_crop, audio_move_set_crop,
+				{CROP(top)}, 1, true},
+	[TRANSFORM_CROP_RIGHT] = {audio_move_get_crop, audio_move_set_crop,
+				  {CROP(right)}, 1, true},
+	[TRANSFORM_CROP_BOTTOM] = {audio_move_get_crop, audio_move_set_crop,
+				   {CROP(bottom)}, 1, true},
+	[TRANSFORM_CROP_HORIZONTAL] = {audio_move_get_crop,
+				       audio_move_set_crop,
+				       {CROP(left), CROP(right)}, 2, true},
+	[TRANSFORM_CROP_VERTICAL] = {audio_move_get_crop, audio_move_set_crop,
+				     {CROP(top), CROP(bottom)}, 2, true},
+};
+
+#undef VEC_X
+#undef VEC_Y
+#undef CROP
+
+static const struct audio_move_transform_setter *
+audio_move_transform_setter(long long transform)
+{
+	if (transform <= TRANSFORM_NONE ||
+	    transform >= (long long)(sizeof(audio_move_transform_setters) /
+				     sizeof(audio_move_transform_setters[0])))
+		return NULL;
+	return &audio_move_transform_setters[transform];
+}
+
+static void
+audio_move_set_transform(obs_sceneitem_t *item,
+			 const struct audio_move_transform_setter *setter,
+			 double val)
+{
+	union audio_move_transform_value value;
+	if (setter->get)
+		setter->get(item, &value);
+	for (size_t i = 0; i < setter->components; i++) {
+		uint8_t *component = (uint8_t *)&value + setter->offset[i];
+		if (setter->is_int)
+			*(int *)component = (int)val;
+		else
+			*(float *)component = (float)val;
+	}
+	setter->set(item, &value);
+}
+
+static bool audio_move_value_changed(struct audio_move_info *audio_move,
+				     double val)
+{
+	if (audio_move->last_value_set &&
+	    fabs(val - audio_move->last_value) <= audio_move->min_change)
+		return false;
+	audio_move->last_value = val;
+	audio_move->last_value_set = true;
+	return true;
+}
+
+static void audio_move_resolve_signal(void *data, calldata_t *call_data)
+{
+	UNUSED_PARAMETER(call_data);
+	struct audio_move_info *audio_move = data;
+	os_atomic_set_bool(&audio_move->resolve_pending, true);
+}
+
+static void audio_move_watch_scene(struct audio_move_info *audio_move,
+				   obs_source_t *scene_source)
+{
+	if (audio_move->resolve_scene) {
+		obs_source_t *source =
+			obs_weak_source_get_source(audio_move->resolve_scene);
+		if (source) {
+			signal_handler_disconnect(
+				obs_source_get_signal_handler(source),
+				"item_add", audio_move_resolve_signal,
+				audio_move);
+			obs_source_release(source);
+		}
+		obs_weak_source_release(audio_move->resolve_scene);
+		audio_move->resolve_scene = NULL;
+	}
+	if (!scene_source)
+		return;
+	audio_move->resolve_scene = obs_source_get_weak_source(scene_source);
+	signal_handler_connect(obs_source_get_signal_handler(scene_source),
+			       "item_add", audio_move_resolve_signal,
+			       audio_move);
+}
+
+static bool audio_move_target_missing(struct audio_move_info *audio_move)
+{
+	if (audio_move->action == VALUE_ACTION_TRANSFORM ||
+	    audio_move->action == VALUE_ACTION_SOURCE_VISIBILITY)
+		return !audio_move->sceneitem;
+	if (audio_move->action == VALUE_ACTION_FILTER_ENABLE ||
+	    audio_move->action == VALUE_ACTION_SETTING)
+		return !audio_move->target_source;
+	return false;
+}
+
+void audio_move_update(void *data, obs_data_t *settings);
+
+/* retries the lookup of a missing target once a signal hinted that it may
+ * exist now, backing off while the retries keep failing */
+static void audio_move_resolve(struct audio_move_info *audio_move)
+{
+	if (!os_atomic_load_bool(&audio_move->resolve_pending))
+		return;
+	const uint64_t now = os_gettime_ns();
+	if (now < audio_move->resolve_next)
+		return;
+	os_atomic_set_bool(&audio_move->resolve_pending, false);
+	obs_data_t *settings = obs_source_get_settings(audio_move->source);
+	audio_move_update(audio_move, settings);
+	obs_data_release(settings);
+	if (!audio_move_target_missing(audio_move)) {
+		audio_move->resolve_backoff = 0;
+		audio_move->resolve_next = 0;
+		return;
+	}
+	audio_move->resolve_backoff =
+		audio_move->resolve_backoff
+			? audio_move->resolve_backoff * 2
+			: RESOLVE_BACKOFF_MIN;
+	if (audio_move->resolve_backoff > RESOLVE_BACKOFF_MAX)
+		audio_move->resolve_backoff = RESOLVE_BACKOFF_MAX;
+	audio_move->resolve_next = now + audio_move->resolve_backoff;
 }
 
 void audio_move_source_destroy(void *data, calldata_t *call_data)
@@ -97,8 +641,10 @@ void audio_move_item_remove(void *data, calldata_t *call_data);
 
 void audio_move_source_remove(void *data, calldata_t *call_data)
 {
-	UNUSED_PARAMETER(call_data);
 	struct audio_move_info *audio_move = data;
+	obs_source_t *removed = NULL;
+	calldata_get_ptr(call_data, "source", &removed);
+	obs_source_t *scene_source = NULL;
 	if (audio_move->target_source) {
 		obs_source_t *source =
 			obs_weak_source_get_source(audio_move->target_source);
@@ -114,8 +660,9 @@ void audio_move_source_remove(void *data, calldata_t *call_data)
 	if (audio_move->sceneitem) {
 		obs_scene_t *scene =
 			obs_sceneitem_get_scene(audio_move->sceneitem);
-		signal_handler_t *sh = obs_source_get_signal_handler(
-			obs_scene_get_source(scene));
+		scene_source = obs_scene_get_source(scene);
+		signal_handler_t *sh =
+			obs_source_get_signal_handler(scene_source);
 		if (sh) {
 			signal_handler_disconnect(sh, "item_remove",
 						  audio_move_item_remove,
@@ -140,6 +687,11 @@ void audio_move_source_remove(void *data, calldata_t *call_data)
 		}
 	}
 	audio_move->sceneitem = NULL;
+	/* look for a new target once one may exist, in the scene it was in
+	 * unless that is what got removed */
+	if (scene_source && scene_source != removed)
+		audio_move_watch_scene(audio_move, scene_source);
+	os_atomic_set_bool(&audio_move->resolve_pending, true);
 }
 
 void audio_move_item_remove(void *data, calldata_t *call_data)
@@ -166,7 +718,9 @@ void audio_move_item_remove(void *data, calldata_t *call_data)
 					sh, "destroy",
 					audio_move_source_destroy, audio_move);
 			}
+			audio_move_watch_scene(audio_move, parent);
 		}
+		os_atomic_set_bool(&audio_move->resolve_pending, true);
 	}
 }
 
@@ -175,11 +729,22 @@ void audio_move_update(void *data, obs_data_t *settings)
 	struct audio_move_info *audio_move = data;
 
 	obs_source_t *parent = obs_filter_get_parent(audio_move->source);
-	if (parent)
-		obs_volmeter_attach_source(audio_move->volmeter, parent);
 
 	const long long meter_type = obs_data_get_int(settings, "meter_type");
 	if (meter_type != audio_move->meter_type) {
+		/* the band state only changes while no capture callback can
+		 * run, the attach below adds it back */
+		if (meter_type == METER_TYPE_BAND ||
+		    audio_move->meter_type == METER_TYPE_BAND)
+			audio_move_attach(audio_move, NULL);
+		if (meter_type == METER_TYPE_BAND) {
+			audio_move->band =
+				bzalloc(sizeof(struct audio_move_band));
+			move_fft_init(&audio_move->band->fft);
+		} else {
+			bfree(audio_move->band);
+			audio_move->band = NULL;
+		}
 		audio_move->meter_type = meter_type;
 		if (meter_type == METER_TYPE_INPUT_PEAK_SAMPLE ||
 		    meter_type == METER_TYPE_PEAK_SAMPLE) {
@@ -191,11 +756,57 @@ void audio_move_update(void *data, obs_data_t *settings)
 							 TRUE_PEAK_METER);
 		}
 	}
-	audio_move->easing = obs_data_get_double(settings, "easing") / 100.0;
+	audio_move->direct_capture =
+		obs_data_get_bool(settings, "direct_capture");
+	audio_move_attach(audio_move, parent);
+	if (obs_data_has_user_value(settings, "easing")) {
+		/* the easing was applied once per audio callback of about
+		 * AUDIO_OUTPUT_FRAMES frames */
+		const double easing =
+			obs_data_get_double(settings, "easing") / 100.0;
+		const double sample_rate =
+			(double)audio_output_get_sample_rate(obs_get_audio());
+		if (easing > 0.0 && sample_rate > 0.0) {
+			const double frame_ms =
+				1000.0 * AUDIO_OUTPUT_FRAMES / sample_rate;
+			const double ms = -frame_ms / log(easing);
+			obs_data_set_int(settings, "attack", (long long)ms);
+			obs_data_set_int(settings, "release", (long long)ms);
+		}
+		obs_data_unset_user_value(settings, "easing");
+	}
+	audio_move->attack = obs_data_get_int(settings, "attack") / 1000.0;
+	audio_move->release = obs_data_get_int(settings, "release") / 1000.0;
+	audio_move->channel_mode = obs_data_get_int(settings, "channel_mode");
+	audio_move->channel = obs_data_get_int(settings, "channel");
+	audio_move->channels = audio_output_get_channels(obs_get_audio());
+	audio_move->rms_window =
+		(uint64_t)obs_data_get_int(settings, "rms_window") * 1000000ULL;
+	const float sample_rate =
+		(float)audio_output_get_sample_rate(obs_get_audio());
+	if (sample_rate > 0.0f) {
+		float low = (float)obs_data_get_int(settings, "band_low") /
+			    sample_rate;
+		float high = (float)obs_data_get_int(settings, "band_high") /
+			     sample_rate;
+		if (low > high) {
+			const float swap = low;
+			low = high;
+			high = swap;
+		}
+		audio_move->band_low = low < 0.5f ? low : 0.5f;
+		audio_move->band_high = high < 0.5f ? high : 0.5f;
+	}
 	audio_move->action = obs_data_get_int(settings, "value_action");
 	audio_move->transform = obs_data_get_int(settings, "transform");
+	audio_move->transform_setter =
+		audio_move_transform_setter(audio_move->transform);
 	audio_move->base_value = obs_data_get_double(settings, "base_value");
 	audio_move->factor = obs_data_get_double(settings, "factor");
+	audio_move->min_change = obs_data_get_double(settings, "min_change");
+	audio_move->last_value_set = false;
+	audio_move->setting_num_type = OBS_DATA_NUM_INVALID;
+	audio_move->setting_lookup_failed = false;
 
 	const char *scene_name = obs_data_get_string(settings, "scene");
 	const char *sceneitem_name = obs_data_get_string(settings, "sceneitem");
@@ -236,6 +847,11 @@ void audio_move_update(void *data, obs_data_t *settings)
 		    obs_sceneitem_get_source(audio_move->sceneitem))) {
 		audio_move->sceneitem = NULL;
 	}
+	const bool watch_scene =
+		scene && audio_move_target_missing(audio_move) &&
+		(audio_move->action == VALUE_ACTION_TRANSFORM ||
+		 audio_move->action == VALUE_ACTION_SOURCE_VISIBILITY);
+	audio_move_watch_scene(audio_move, watch_scene ? source : NULL);
 
 	if (audio_move->sceneitem && source) {
 		signal_handler_t *sh = obs_source_get_signal_handler(source);
@@ -329,8 +945,17 @@ void audio_move_update(void *data, obs_data_t *settings)
 	}
 	audio_move->threshold_action =
 		obs_data_get_int(settings, "threshold_action");
+	/* an under threshold that was never set follows the over threshold,
+	 * like filters from before there was one */
+	obs_data_set_default_double(settings, "threshold_under",
+				    obs_data_get_double(settings, "threshold"));
 	audio_move->threshold =
 		obs_data_get_double(settings, "threshold") / 100.0;
+	audio_move->threshold_under =
+		obs_data_get_double(settings, "threshold_under") / 100.0;
+	audio_move->threshold_hold =
+		(uint64_t)obs_data_get_int(settings, "threshold_hold") *
+		1000000ULL;
 	const char *setting_name = obs_data_get_string(settings, "setting");
 	if (!audio_move->setting_name ||
 	    strcmp(audio_move->setting_name, setting_name) != 0) {
@@ -339,14 +964,32 @@ void audio_move_update(void *data, obs_data_t *settings)
 	}
 }
 
+static void audio_move_get_toggles(void *data, calldata_t *call_data)
+{
+	struct audio_move_info *audio_move = data;
+	calldata_set_int(call_data, "toggles", audio_move->toggles);
+}
+
 static void *audio_move_create(obs_data_t *settings, obs_source_t *source)
 {
 	struct audio_move_info *audio_move =
 		bzalloc(sizeof(struct audio_move_info));
 	audio_move->source = source;
+	audio_move->levels_middle = 1;
+	audio_move->levels_front = 2;
 	audio_move->volmeter = obs_volmeter_create(OBS_FADER_LOG);
 	obs_volmeter_add_callback(audio_move->volmeter,
 				  audio_move_volmeter_updated, audio_move);
+	signal_handler_t *sh = obs_get_signal_handler();
+	signal_handler_connect(sh, "source_create", audio_move_resolve_signal,
+			       audio_move);
+	signal_handler_connect(sh, "source_rename", audio_move_resolve_signal,
+			       audio_move);
+	signal_handler_connect(sh, "source_load", audio_move_resolve_signal,
+			       audio_move);
+	proc_handler_add(obs_source_get_proc_handler(source),
+			 "void get_toggles(out int toggles)",
+			 audio_move_get_toggles, audio_move);
 	audio_move_update(audio_move, settings);
 
 	return audio_move;
@@ -355,11 +998,25 @@ static void *audio_move_create(obs_data_t *settings, obs_source_t *source)
 static void audio_move_destroy(void *data)
 {
 	struct audio_move_info *audio_move = data;
+	signal_handler_t *global_sh = obs_get_signal_handler();
+	signal_handler_disconnect(global_sh, "source_create",
+				  audio_move_resolve_signal, audio_move);
+	signal_handler_disconnect(global_sh, "source_rename",
+				  audio_move_resolve_signal, audio_move);
+	signal_handler_disconnect(global_sh, "source_load",
+				  audio_move_resolve_signal, audio_move);
+	audio_move_watch_scene(audio_move, NULL);
+	if (audio_move->capture_source)
+		obs_source_remove_audio_capture_callback(
+			audio_move->capture_source, audio_move_audio_captured,
+			audio_move);
+	audio_move->capture_source = NULL;
 	obs_volmeter_detach_source(audio_move->volmeter);
 	obs_volmeter_remove_callback(audio_move->volmeter,
 				     audio_move_volmeter_updated, audio_move);
 	obs_volmeter_destroy(audio_move->volmeter);
 	audio_move->volmeter = NULL;
+	bfree(audio_move->band);
 	if (audio_move->target_source) {
 		obs_source_t *source =
 			obs_weak_source_get_source(audio_move->target_source);
@@ -407,6 +1064,7 @@ static void audio_move_destroy(void *data)
 	}
 	audio_move->sceneitem = NULL;
 	bfree(audio_move->setting_name);
+	obs_data_release(audio_move->setting_data);
 	bfree(audio_move);
 }
 
@@ -452,24 +1110,35 @@ static bool audio_move_action_changed(obs_properties_t *props,
 	}
 	obs_property_t *base_value = obs_properties_get(props, "base_value");
 	obs_property_t *factor = obs_properties_get(props, "factor");
+	obs_property_t *min_change = obs_properties_get(props, "min_change");
 	if (action == VALUE_ACTION_SETTING ||
 	    action == VALUE_ACTION_TRANSFORM) {
 		obs_property_set_visible(base_value, true);
 		obs_property_set_visible(factor, true);
+		obs_property_set_visible(min_change, true);
 	} else {
 		obs_property_set_visible(base_value, false);
 		obs_property_set_visible(factor, false);
+		obs_property_set_visible(min_change, false);
 	}
 	obs_property_t *threshold_action =
 		obs_properties_get(props, "threshold_action");
 	obs_property_t *threshold = obs_properties_get(props, "threshold");
+	obs_property_t *threshold_under =
+		obs_properties_get(props, "threshold_under");
+	obs_property_t *threshold_hold =
+		obs_properties_get(props, "threshold_hold");
 	if (action == VALUE_ACTION_SOURCE_VISIBILITY ||
 	    action == VALUE_ACTION_FILTER_ENABLE) {
 		obs_property_set_visible(threshold_action, true);
 		obs_property_set_visible(threshold, true);
+		obs_property_set_visible(threshold_under, true);
+		obs_property_set_visible(threshold_hold, true);
 	} else {
 		obs_property_set_visible(threshold_action, false);
 		obs_property_set_visible(threshold, false);
+		obs_property_set_visible(threshold_under, false);
+		obs_property_set_visible(threshold_hold, false);
 	}
 	obs_property_t *transform = obs_properties_get(props, "transform");
 	if (action == VALUE_ACTION_TRANSFORM) {
@@ -486,6 +1155,65 @@ static bool audio_move_action_changed(obs_properties_t *props,
 	return true;
 }
 
+static bool audio_move_meter_type_changed(obs_properties_t *props,
+					  obs_property_t *property,
+					  obs_data_t *settings)
+{
+	UNUSED_PARAMETER(property);
+	const long long meter_type = obs_data_get_int(settings, "meter_type");
+	const bool band = meter_type == METER_TYPE_BAND;
+	obs_property_set_visible(obs_properties_get(props, "band_low"), band);
+	obs_property_set_visible(obs_properties_get(props, "band_high"), band);
+	obs_property_set_visible(obs_properties_get(props, "direct_capture"),
+				 audio_move_direct_capture(meter_type));
+	return true;
+}
+
+/* the under threshold can not go over the over threshold */
+static bool audio_move_threshold_changed(obs_properties_t *props,
+					 obs_property_t *property,
+					 obs_data_t *settings)
+{
+	UNUSED_PARAMETER(property);
+	const double threshold = obs_data_get_double(settings, "threshold");
+	obs_data_set_default_double(settings, "threshold_under", threshold);
+	if (obs_data_get_double(settings, "threshold_under") > threshold)
+		obs_data_set_double(settings, "threshold_under", threshold);
+	obs_property_float_set_limits(
+		obs_properties_get(props, "threshold_under"), 0.0, threshold,
+		0.01);
+	return true;
+}
+
+/* keeps the band at least one step wide, the limits keep it below nyquist */
+static bool audio_move_band_changed(obs_properties_t *props,
+				    obs_property_t *property,
+				    obs_data_t *settings)
+{
+	UNUSED_PARAMETER(props);
+	const long long low = obs_data_get_int(settings, "band_low");
+	const long long high = obs_data_get_int(settings, "band_high");
+	if (low < high)
+		return false;
+	if (strcmp(obs_property_name(property), "band_low") == 0)
+		obs_data_set_int(settings, "band_high", low + BAND_STEP);
+	else
+		obs_data_set_int(settings, "band_low", high - BAND_STEP);
+	return true;
+}
+
+static bool audio_move_channel_mode_changed(obs_properties_t *props,
+					    obs_property_t *property,
+					    obs_data_t *settings)
+{
+	UNUSED_PARAMETER(property);
+	obs_property_t *channel = obs_properties_get(props, "channel");
+	obs_property_set_visible(channel,
+				 obs_data_get_int(settings, "channel_mode") ==
+					 CHANNEL_MODE_SINGLE);
+	return true;
+}
+
 static bool add_sceneitem_to_prop_list(obs_scene_t *scene,
 				       obs_sceneitem_t *item, void *data)
 {
@@ -602,9 +1330,51 @@ static obs_properties_t *audio_move_properties(void *data)
 				  METER_TYPE_INPUT_PEAK_SAMPLE);
 	obs_property_list_add_int(p, obs_module_text("MeterType.InputPeakTrue"),
 				  METER_TYPE_INPUT_PEAK_TRUE);
+	obs_property_list_add_int(p, obs_module_text("MeterType.Band"),
+				  METER_TYPE_BAND);
+	obs_property_set_modified_callback(p, audio_move_meter_type_changed);
+
+	obs_properties_add_bool(ppts, "direct_capture",
+				obs_module_text("DirectCapture"));
+
+	const int nyquist =
+		(int)audio_output_get_sample_rate(obs_get_audio()) / 2;
+	p = obs_properties_add_int(ppts, "band_low",
+				   obs_module_text("BandLow"), 0,
+				   nyquist - BAND_STEP, BAND_STEP);
+	obs_property_int_set_suffix(p, "Hz");
+	obs_property_set_modified_callback(p, audio_move_band_changed);
+	p = obs_properties_add_int(ppts, "band_high",
+				   obs_module_text("BandHigh"), BAND_STEP,
+				   nyquist, BAND_STEP);
+	obs_property_int_set_suffix(p, "Hz");
+	obs_property_set_modified_callback(p, audio_move_band_changed);
+
+	p = obs_properties_add_list(ppts, "channel_mode",
+				    obs_module_text("ChannelMode"),
+				    OBS_COMBO_TYPE_LIST, OBS_COMBO_FORMAT_INT);
+	obs_property_list_add_int(p, obs_module_text("ChannelMode.Single"),
+				  CHANNEL_MODE_SINGLE);
+	obs_property_list_add_int(p, obs_module_text("ChannelMode.Max"),
+				  CHANNEL_MODE_MAX);
+	obs_property_list_add_int(p, obs_module_text("ChannelMode.Mean"),
+				  CHANNEL_MODE_MEAN);
+	obs_property_set_modified_callback(p, audio_move_channel_mode_changed);
+
+	obs_properties_add_int(ppts, "channel", obs_module_text("Channel"), 1,
+			       MAX_AUDIO_CHANNELS, 1);
 
-	p = obs_properties_add_float_slider(
-		ppts, "easing", obs_module_text("Easing"), 0.0, 99.99, 0.01);
+	p = obs_properties_add_int(ppts, "rms_window",
+				   obs_module_text("RmsWindow"), 0,
+				   RMS_WINDOW_MAX, 10);
+	obs_property_int_set_suffix(p, "ms");
+
+	p = obs_properties_add_int(ppts, "attack", obs_module_text("Attack"), 0,
+				   10000, 1);
+	obs_property_int_set_suffix(p, "ms");
+	p = obs_properties_add_int(ppts, "release", obs_module_text("Release"),
+				   0, 10000, 1);
+	obs_property_int_set_suffix(p, "ms");
 
 	p = obs_properties_add_list(ppts, "value_action",
 				    obs_module_text("ValueAction"),
@@ -685,6 +1455,9 @@ static obs_properties_t *audio_move_properties(void *data)
 				     DBL_MAX, 0.01);
 	p = obs_properties_add_float(ppts, "factor", obs_module_text("Factor"),
 				     -DBL_MAX, DBL_MAX, 0.01);
+	p = obs_properties_add_float(ppts, "min_change",
+				     obs_module_text("MinChange"), 0.0, DBL_MAX,
+				     0.001);
 	p = obs_properties_add_list(ppts, "threshold_action",
 				    obs_module_text("ThresholdAction"),
 				    OBS_COMBO_TYPE_LIST, OBS_COMBO_FORMAT_INT);
@@ -711,6 +1484,14 @@ static obs_properties_t *audio_move_properties(void *data)
 	p = obs_properties_add_float_slider(ppts, "threshold",
 					    obs_module_text("Threshold"), 0.0,
 					    100.0, 0.01);
+	obs_property_set_modified_callback(p, audio_move_threshold_changed);
+	p = obs_properties_add_float_slider(ppts, "threshold_under",
+					    obs_module_text("ThresholdUnder"),
+					    0.0, 100.0, 0.01);
+	p = obs_properties_add_int(ppts, "threshold_hold",
+				   obs_module_text("ThresholdHold"), 0, 10000,
+				   10);
+	obs_property_int_set_suffix(p, "ms");
 	obs_properties_add_text(ppts, "plugin_info", PLUGIN_INFO,
 				OBS_TEXT_INFO);
 	return ppts;
@@ -719,224 +1500,181 @@ static obs_properties_t *audio_move_properties(void *data)
 void audio_move_defaults(obs_data_t *settings)
 {
 	obs_data_set_default_double(settings, "factor", 1000.0);
+	obs_data_set_default_int(settings, "channel", 1);
+	obs_data_set_default_int(settings, "band_low", 20);
+	obs_data_set_default_int(settings, "band_high", 250);
+	obs_data_set_default_double(settings, "min_change", 0.001);
+}
+
+/* the state the threshold action asks for, false while the level is between
+ * the under and over thresholds or the action does not apply */
+static bool audio_move_threshold_state(struct audio_move_info *audio_move,
+				       bool *enable)
+{
+	const long long action = audio_move->threshold_action;
+	if (audio_move->audio_value >= audio_move->threshold) {
+		if (action == THRESHOLD_ENABLE_OVER ||
+		    action == THRESHOLD_ENABLE_OVER_DISABLE_UNDER) {
+			*enable = true;
+			return true;
+		}
+		if (action == THRESHOLD_DISABLE_OVER ||
+		    action == THRESHOLD_ENABLE_UNDER_DISABLE_OVER) {
+			*enable = false;
+			return true;
+		}
+	} else if (audio_move->audio_value < audio_move->threshold_under) {
+		if (action == THRESHOLD_ENABLE_UNDER ||
+		    action == THRESHOLD_ENABLE_UNDER_DISABLE_OVER) {
+			*enable = true;
+			return true;
+		}
+		if (action == THRESHOLD_DISABLE_UNDER ||
+		    action == THRESHOLD_ENABLE_OVER_DISABLE_UNDER) {
+			*enable = false;
+			return true;
+		}
+	}
+	return false;
+}
+
+/* allows a change of state once the previous change was held long enough */
+static bool audio_move_toggle(struct audio_move_info *audio_move,
+			      bool enabled, bool enable)
+{
+	if (enabled == enable)
+		return false;
+	const uint64_t now = os_gettime_ns();
+	if (audio_move->toggles &&
+	    now - audio_move->toggle_time < audio_move->threshold_hold)
+		return false;
+	audio_move->toggle_time = now;
+	audio_move->toggles++;
+	return true;
+}
+
+/* follows the level with the attack time constant while it rises and the
+ * release time constant while it falls, over the real frame time */
+static void audio_move_smooth(struct audio_move_info *audio_move, double v,
+			      float seconds)
+{
+	const double tau = v > audio_move->audio_value ? audio_move->attack
+						       : audio_move->release;
+	if (tau <= 0.0 || seconds <= 0.0f) {
+		audio_move->audio_value = v;
+		return;
+	}
+	audio_move->audio_value +=
+		(v - audio_move->audio_value) * (1.0 - exp(-seconds / tau));
+}
+
+/* the level at the frame time, running one callback behind the audio so it
+ * moves from the previous to the latest level in between callbacks instead
+ * of stepping when a callback arrives */
+static double audio_move_level_at(const struct audio_move_levels *levels,
+				  uint64_t time)
+{
+	if (!levels->prev_timestamp ||
+	    levels->timestamp <= levels->prev_timestamp)
+		return levels->value;
+	if (time <= levels->timestamp)
+		return levels->prev_value;
+	const double t = (double)(time - levels->timestamp) /
+			 (double)(levels->timestamp - levels->prev_timestamp);
+	if (t >= 1.0)
+		return levels->value;
+	return levels->prev_value + (levels->value - levels->prev_value) * t;
 }
 
 void audio_move_tick(void *data, float seconds)
 {
-	UNUSED_PARAMETER(seconds);
 	struct audio_move_info *filter = data;
 	if (!obs_source_enabled(filter->source))
 		return;
+	struct audio_move_levels levels;
+	audio_move_levels_read(filter, &levels);
+	audio_move_smooth(filter,
+			  audio_move_level_at(&levels,
+					      obs_get_video_frame_time()),
+			  seconds);
 	if (filter->action == VALUE_ACTION_TRANSFORM) {
-		if (!filter->sceneitem) {
-			obs_data_t *settings =
-				obs_source_get_settings(filter->source);
-			audio_move_update(filter, settings);
-			obs_data_release(settings);
-		}
 		if (!filter->sceneitem)
+			audio_move_resolve(filter);
+		if (!filter->sceneitem || !filter->transform_setter)
 			return;
-		if (filter->transform == TRANSFORM_POS_X) {
-			struct vec2 pos;
-			obs_sceneitem_get_pos(filter->sceneitem, &pos);
-			pos.x = (float)(filter->factor * filter->audio_value +
-					filter->base_value);
-			obs_sceneitem_set_pos(filter->sceneitem, &pos);
-		} else if (filter->transform == TRANSFORM_POS_Y) {
-			struct vec2 pos;
-			obs_sceneitem_get_pos(filter->sceneitem, &pos);
-			pos.y = (float)(filter->factor * filter->audio_value +
-					filter->base_value);
-			obs_sceneitem_set_pos(filter->sceneitem, &pos);
-		} else if (filter->transform == TRANSFORM_ROT) {
-			obs_sceneitem_set_rot(
-				filter->sceneitem,
-				(float)(filter->factor * filter->audio_value +
-					filter->base_value));
-		} else if (filter->transform == TRANSFORM_SCALE) {
-			struct vec2 scale;
-			scale.x = (float)(filter->factor * filter->audio_value +
-					  filter->base_value);
-			scale.y = scale.x;
-			obs_sceneitem_set_scale(filter->sceneitem, &scale);
-		} else if (filter->transform == TRANSFORM_SCALE_X) {
-			struct vec2 scale;
-			obs_sceneitem_get_scale(filter->sceneitem, &scale);
-			scale.x = (float)(filter->factor * filter->audio_value +
-					  filter->base_value);
-			obs_sceneitem_set_scale(filter->sceneitem, &scale);
-		} else if (filter->transform == TRANSFORM_SCALE_Y) {
-			struct vec2 scale;
-			obs_sceneitem_get_scale(filter->sceneitem, &scale);
-			scale.y = (float)(filter->factor * filter->audio_value +
-					  filter->base_value);
-			obs_sceneitem_set_scale(filter->sceneitem, &scale);
-		} else if (filter->transform == TRANSFORM_BOUNDS_X) {
-			struct vec2 bounds;
-			obs_sceneitem_get_bounds(filter->sceneitem, &bounds);
-			bounds.x =
-				(float)(filter->factor * filter->audio_value +
-					filter->base_value);
-			obs_sceneitem_set_scale(filter->sceneitem, &bounds);
-		} else if (filter->transform == TRANSFORM_BOUNDS_Y) {
-			struct vec2 bounds;
-			obs_sceneitem_get_bounds(filter->sceneitem, &bounds);
-			bounds.y =
-				(float)(filter->factor * filter->audio_value +
-					filter->base_value);
-			obs_sceneitem_set_scale(filter->sceneitem, &bounds);
-		} else if (filter->transform == TRANSFORM_CROP_LEFT) {
-			struct obs_sceneitem_crop crop;
-			obs_sceneitem_get_crop(filter->sceneitem, &crop);
-			crop.left = (int)(filter->factor * filter->audio_value +
-					  filter->base_value);
-			obs_sceneitem_set_crop(filter->sceneitem, &crop);
-		} else if (filter->transform == TRANSFORM_CROP_TOP) {
-			struct obs_sceneitem_crop crop;
-			obs_sceneitem_get_crop(filter->sceneitem, &crop);
-			crop.top = (int)(filter->factor * filter->audio_value +
-					 filter->base_value);
-			obs_sceneitem_set_crop(filter->sceneitem, &crop);
-		} else if (filter->transform == TRANSFORM_CROP_RIGHT) {
-			struct obs_sceneitem_crop crop;
-			obs_sceneitem_get_crop(filter->sceneitem, &crop);
-			crop.right =
-				(int)(filter->factor * filter->audio_value +
-				      filter->base_value);
-			obs_sceneitem_set_crop(filter->sceneitem, &crop);
-		} else if (filter->transform == TRANSFORM_CROP_BOTTOM) {
-			struct obs_sceneitem_crop crop;
-			obs_sceneitem_get_crop(filter->sceneitem, &crop);
-			crop.bottom =
-				(int)(filter->factor * filter->audio_value +
-				      filter->base_value);
-			obs_sceneitem_set_crop(filter->sceneitem, &crop);
-		} else if (filter->transform == TRANSFORM_CROP_HORIZONTAL) {
-			struct obs_sceneitem_crop crop;
-			obs_sceneitem_get_crop(filter->sceneitem, &crop);
-			crop.left = (int)(filter->factor * filter->audio_value +
-					  filter->base_value);
-			crop.right = crop.left;
-			obs_sceneitem_set_crop(filter->sceneitem, &crop);
-		} else if (filter->transform == TRANSFORM_CROP_VERTICAL) {
-			struct obs_sceneitem_crop crop;
-			obs_sceneitem_get_crop(filter->sceneitem, &crop);
-			crop.top = (int)(filter->factor * filter->audio_value +
-					 filter->base_value);
-			crop.bottom = crop.top;
-			obs_sceneitem_set_crop(filter->sceneitem, &crop);
-		}
-
+		const double val = filter->factor * filter->audio_value +
+				   filter->base_value;
+		if (!audio_move_value_changed(filter, val))
+			return;
+		audio_move_set_transform(filter->sceneitem,
+					 filter->transform_setter, val);
 	} else if (filter->action == VALUE_ACTION_SOURCE_VISIBILITY) {
-		if (!filter->sceneitem) {
-			obs_data_t *settings =
-				obs_source_get_settings(filter->source);
-			audio_move_update(filter, settings);
-			obs_data_release(settings);
-		}
+		if (!filter->sceneitem)
+			audio_move_resolve(filter);
 		if (!filter->sceneitem)
 			return;
-		if ((filter->threshold_action == THRESHOLD_ENABLE_OVER ||
-		     filter->threshold_action ==
-			     THRESHOLD_ENABLE_OVER_DISABLE_UNDER) &&
-		    filter->audio_value >= filter->threshold) {
-			obs_sceneitem_set_visible(filter->sceneitem, true);
-		} else if ((filter->threshold_action ==
-				    THRESHOLD_ENABLE_UNDER ||
-			    filter->threshold_action ==
-				    THRESHOLD_ENABLE_UNDER_DISABLE_OVER) &&
-			   filter->audio_value < filter->threshold) {
-			obs_sceneitem_set_visible(filter->sceneitem, true);
-		} else if ((filter->threshold_action ==
-				    THRESHOLD_DISABLE_OVER ||
-			    filter->threshold_action ==
-				    THRESHOLD_ENABLE_UNDER_DISABLE_OVER) &&
-			   filter->audio_value >= filter->threshold) {
-			obs_sceneitem_set_visible(filter->sceneitem, false);
-		} else if ((filter->threshold_action ==
-				    THRESHOLD_DISABLE_UNDER ||
-			    filter->threshold_action ==
-				    THRESHOLD_ENABLE_OVER_DISABLE_UNDER) &&
-			   filter->audio_value < filter->threshold) {
-			obs_sceneitem_set_visible(filter->sceneitem, false);
-		}
+		bool visible;
+		if (audio_move_threshold_state(filter, &visible) &&
+		    audio_move_toggle(filter,
+				      obs_sceneitem_visible(filter->sceneitem),
+				      visible))
+			obs_sceneitem_set_visible(filter->sceneitem, visible);
 	} else if (filter->action == VALUE_ACTION_FILTER_ENABLE) {
-		if (!filter->target_source) {
-			obs_data_t *settings =
-				obs_source_get_settings(filter->source);
-			audio_move_update(filter, settings);
-			obs_data_release(settings);
-		}
+		if (!filter->target_source)
+			audio_move_resolve(filter);
 		if (!filter->target_source)
 			return;
 		obs_source_t *source =
 			obs_weak_source_get_source(filter->target_source);
 		if (!source)
 			return;
-
-		if ((filter->threshold_action == THRESHOLD_ENABLE_OVER ||
-		     filter->threshold_action ==
-			     THRESHOLD_ENABLE_OVER_DISABLE_UNDER) &&
-		    filter->audio_value >= filter->threshold &&
-		    !obs_source_enabled(source)) {
-			obs_source_set_enabled(source, true);
-		} else if ((filter->threshold_action ==
-				    THRESHOLD_ENABLE_UNDER ||
-			    filter->threshold_action ==
-				    THRESHOLD_ENABLE_UNDER_DISABLE_OVER) &&
-			   filter->audio_value < filter->threshold &&
-			   !obs_source_enabled(source)) {
-			obs_source_set_enabled(source, true);
-		} else if ((filter->threshold_action ==
-				    THRESHOLD_DISABLE_OVER ||
-			    filter->threshold_action ==
-				    THRESHOLD_ENABLE_UNDER_DISABLE_OVER) &&
-			   filter->audio_value >= filter->threshold &&
-			   obs_source_enabled(source)) {
-			obs_source_set_enabled(source, false);
-		} else if ((filter->threshold_action ==
-				    THRESHOLD_DISABLE_UNDER ||
-			    filter->threshold_action ==
-				    THRESHOLD_ENABLE_OVER_DISABLE_UNDER) &&
-			   filter->audio_value < filter->threshold &&
-			   obs_source_enabled(source)) {
-			obs_source_set_enabled(source, false);
-		}
+		bool enable;
+		if (audio_move_threshold_state(filter, &enable) &&
+		    audio_move_toggle(filter, obs_source_enabled(source),
+				      enable))
+			obs_source_set_enabled(source, enable);
 		obs_source_release(source);
 	} else if (filter->action == VALUE_ACTION_SETTING &&
 		   filter->setting_name && strlen(filter->setting_name)) {
-		if (!filter->target_source) {
-			obs_data_t *settings =
-				obs_source_get_settings(filter->source);
-			audio_move_update(filter, settings);
-			obs_data_release(settings);
-		}
 		if (!filter->target_source)
+			audio_move_resolve(filter);
+		if (!filter->target_source || filter->setting_lookup_failed)
 			return;
 		obs_source_t *source =
 			obs_weak_source_get_source(filter->target_source);
 		if (!source)
 			return;
-		obs_data_t *settings = obs_source_get_settings(source);
-		const double val = filter->factor * filter->audio_value +
-				   filter->base_value;
-		obs_data_item_t *setting =
-			obs_data_item_byname(settings, filter->setting_name);
-		if (setting) {
-			const enum obs_data_number_type num_type =
-				obs_data_item_numtype(setting);
-			if (num_type == OBS_DATA_NUM_INT) {
-				obs_data_item_set_int(&setting, (long long)val);
-			} else if (num_type == OBS_DATA_NUM_DOUBLE) {
-				obs_data_item_set_double(&setting, val);
-			}
+		if (filter->setting_num_type == OBS_DATA_NUM_INVALID) {
+			obs_data_t *settings = obs_source_get_settings(source);
+			obs_data_item_t *setting = obs_data_item_byname(
+				settings, filter->setting_name);
+			filter->setting_num_type =
+				setting ? obs_data_item_numtype(setting)
+					: OBS_DATA_NUM_DOUBLE;
 			obs_data_item_release(&setting);
+			obs_data_release(settings);
+			if (filter->setting_num_type == OBS_DATA_NUM_INVALID)
+				filter->setting_lookup_failed = true;
+			obs_data_release(filter->setting_data);
+			filter->setting_data = obs_data_create();
+		}
+		double val = filter->factor * filter->audio_value +
+			     filter->base_value;
+		if (filter->setting_num_type == OBS_DATA_NUM_INT)
+			val = (double)(long long)val;
+		if (filter->setting_lookup_failed ||
+		    !audio_move_value_changed(filter, val)) {
+			obs_source_release(source);
+			return;
+		}
+		if (filter->setting_num_type == OBS_DATA_NUM_INT) {
+			obs_data_set_int(filter->setting_data,
+					 filter->setting_name, (long long)val);
 		} else {
-			obs_data_set_double(settings, filter->setting_name,
-					    val);
+			obs_data_set_double(filter->setting_data,
+					    filter->setting_name, val);
 		}
-		obs_data_release(settings);
-		obs_source_update(source, NULL);
+		obs_source_update(source, filter->setting_data);
 		obs_source_release(source);
 	}
 }
@@ -0,0 +1,290 @@
+#include "eval-json.h"
+#include <stdlib.h>
+#include <string.h>
+
+struct json_parser {
+	const char *pos;
+	const char *error;
+};
+
+static struct json_value *parse_value(struct json_parser *p);
+
+static void skip_space(struct json_parser *p)
+{
+	while (*p->pos == ' ' || *p->pos == '\t' || *p->pos == '\n' ||
+	       *p->pos == '\r')
+		p->pos++;
+}
+
+static struct json_value *new_value(enum json_type type)
+{
+	struct json_value *v = calloc(1, sizeof(struct json_value));
+	if (v)
+		v->type = type;
+	return v;
+}
+
+static size_t utf8_encode(char *dst, unsigned long c)
+{
+	if (c < 0x80) {
+		dst[0] = (char)c;
+		return 1;
+	} else if (c < 0x800) {
+		dst[0] = (char)(0xC0 | (c >> 6));
+		dst[1] = (char)(0x80 | (c & 0x3F));
+		return 2;
+	} else if (c < 0x10000) {
+		dst[0] = (char)(0xE0 | (c >> 12));
+		dst[1] = (char)(0x80 | ((c >> 6) & 0x3F));
+		dst[2] = (char)(0x80 | (c & 0x3F));
+		return 3;
+	}
+	dst[0] = (char)(0xF0 | (c >> 18));
+	dst[1] = (char)(0x80 | ((c >> 12) & 0x3F));
+	dst[2] = (char)(0x80 | ((c >> 6) & 0x3F));
+	dst[3] = (char)(0x80 | (c & 0x3F));
+	return 4;
+}
+
+static char *parse_string(struct json_parser *p)
+{
+	if (*p->pos != '"') {
+		p->error = "expected string";
+		return NULL;
+	}
+	p->pos++;
+	const char *end = p->pos;
+	while (*end && *end != '"') {
+		if (*end == '\\' && end[1])
+			end++;
+		end++;
+	}
+	if (!*end) {
+		p->error = "unterminated string";
+		return NULL;
+	}
+	/* escapes never expand, so the raw length is an upper bound */
+	char *str = malloc((size_t)(end - p->pos) + 1);
+	if (!str) {
+		p->error = "out of memory";
+		return NULL;
+	}
+	size_t len = 0;
+	while (p->pos < end) {
+		char c = *p->pos++;
+		if (c != '\\') {
+			str[len++] = c;
+			continue;
+		}
+		c = *p->pos++;
+		if (c == 'n') {
+			str[len++] = '\n';
+		} else if (c == 't') {
+			str[len++] = '\t';
+		} else if (c == 'r') {
+			str[len++] = '\r';
+		} else if (c == 'b') {
+			str[len++] = '\b';
+		} else if (c == 'f') {
+			str[len++] = '\f';
+		} else if (c == 'u' && end - p->pos >= 4) {
+			char hex[5] = {0};
+			memcpy(hex, p->pos, 4);
+			p->pos += 4;
+			len += utf8_encode(str + len, strtoul(hex, NULL, 16));
+		} else {
+			str[len++] = c;
+		}
+	}
+	str[len] = '\0';
+	p->pos = end + 1;
+	return str;
+}
+
+static struct json_value *parse_container(struct json_parser *p, bool object)
+{
+	struct json_value *v = new_value(object ? JSON_OBJECT : JSON_ARRAY);
+	if (!v) {
+		p->error = "out of memory";
+		return NULL;
+	}
+	const char close = object ? '}' : ']';
+	struct json_value **tail = &v->child;
+	p->pos++;
+	skip_space(p);
+	if (*p->pos == close) {
+		p->pos++;
+		return v;
+	}
+	while (true) {
+		char *key = NULL;
+		if (object) {
+			skip_space(p);
+			key = parse_string(p);
+			if (!key)
+				break;
+			skip_space(p);
+			if (*p->pos != ':') {
+				free(key);
+				p->error = "expected ':'";
+				break;
+			}
+			p->pos++;
+		}
+		struct json_value *item = parse_value(p);
+		if (!item) {
+			free(key);
+			break;
+		}
+		item->key = key;
+		*tail = item;
+		tail = &item->next;
+		skip_space(p);
+		if (*p->pos == ',') {
+			p->pos++;
+		} else if (*p->pos == close) {
+			p->pos++;
+			return v;
+		} else {
+			p->error = object ? "expected ',' or '}'"
+					  : "expected ',' or ']'";
+			break;
+		}
+	}
+	json_free(v);
+	return NULL;
+}
+
+static struct json_value *parse_value(struct json_parser *p)
+{
+	skip_space(p);
+	struct json_value *v = NULL;
+	if (*p->pos == '{' || *p->pos == '[') {
+		return parse_container(p, *p->pos == '{');
+	} else if (*p->pos == '"') {
+		char *str = parse_string(p);
+		if (!str)
+			return NULL;
+		v = new_value(JSON_STRING);
+		if (v)
+			v->string = str;
+		else
+			free(str);
+	} else if (strncmp(p->pos, "true", 4) == 0) {
+		p->pos += 4;
+		v = new_value(JSON_BOOL);
+		if (v)
+			v->boolean = true;
+	} else if (strncmp(p->pos, "false", 5) == 0) {
+		p->pos += 5;
+		v = new_value(JSON_BOOL);
+	} else if (strncmp(p->pos, "null", 4) == 0) {
+		p->pos += 4;
+		v = new_value(JSON_NULL);
+	} else {
+		char *end;
+		const double number = strtod(p->pos, &end);
+		if (end == p->pos) {
+			p->error = "unexpected character";
+			return NULL;
+		}
+		p->pos = end;
+		v = new_value(JSON_NUMBER);
+		if (v)
+			v->number = number;
+	}
+	if (!v)
+		p->error = "out of memory";
+	return v;
+}
+
+struct json_value *json_parse(const char *text, const char **error)
+{
+	struct json_parser p = {text, NULL};
+	struct json_value *v = parse_value(&p);
+	if (v) {
+		skip_space(&p);
+		if (*p.pos) {
+			p.error = "trailing characters";
+			json_free(v);
+			v = NULL;
+		}
+	}
+	if (error)
+		*error = p.error;
+	return v;
+}
+
+void json_free(struct json_value *value)
+{
+	while (value) {
+		struct json_value *next = value->next;
+		json_free(value->child);
+		free(value->key);
+		free(value->string);
+		free(value);
+		value = next;
+	}
+}
+
+struct json_value *json_get(const struct json_value *obj, const char *key)
+{
+	if (!obj || obj->type != JSON_OBJECT)
+		return NULL;
+	for (struct json_value *v = obj->child; v; v = v->next) {
+		if (v->key && strcmp(v->key, key) == 0)
+			return v;
+	}
+	return NULL;
+}
+
+size_t json_count(const struct json_value *array)
+{
+	size_t count = 0;
+	if (!array || array->type != JSON_ARRAY)
+		return 0;
+	for (struct json_value *v = array->child; v; v = v->next)
+		count++;
+	return count;
+}
+
+const char *json_get_string(const struct json_value *obj, const char *key,
+			    const char *def)
+{
+	const struct json_value *v = json_get(obj, key);
+	return (v && v->type == JSON_STRING) ? v->string : def;
+}
+
+long long json_get_int(const struct json_value *obj, const char *key,
+		       long long def)
+{
+	const struct json_value *v = json_get(obj, key);
+	if (v && v->type == JSON_NUMBER)
+		return (long long)v->number;
+	if (v && v->type == JSON_BOOL)
+		return v->boolean ? 1 : 0;
+	return def;
+}
+
+double json_get_double(const struct json_value *obj, const char *key,
+		       double def)
+{
+	const struct json_value *v = json_get(obj, key);
+	return (v && v->type == JSON_NUMBER) ? v->number : def;
+}
+
+bool json_get_bool(const struct json_value *obj, const char *key, bool def)
+{
+	const struct json_value *v = json_get(obj, key);
+	if (v && v->type == JSON_BOOL)
+		return v->boolean;
+	if (v && v->type == JSON_NUMBER)
+		return v->number != 0.0;
+	return def;
+}
+
+char json_get_char(const struct json_value *obj, const char *key)
+{
+	const char *s = json_get_string(obj, key, NULL);
+	return (s && strlen(s)) ? s[0] : ' ';
+}
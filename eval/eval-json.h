@@ -0,0 +1,41 @@
+#pragma once
+
+/* Minimal read-only JSON tree, just enough to load the filter settings of
+ * an OBS scene collection without pulling in libobs. */
+
+#include <stdbool.h>
+#include <stddef.h>
+
+enum json_type {
+	JSON_NULL,
+	JSON_BOOL,
+	JSON_NUMBER,
+	JSON_STRING,
+	JSON_ARRAY,
+	JSON_OBJECT,
+};
+
+struct json_value {
+	enum json_type type;
+	char *key;
+	char *string;
+	double number;
+	bool boolean;
+	struct json_value *child;
+	struct json_value *next;
+};
+
+struct json_value *json_parse(const char *text, const char **error);
+void json_free(struct json_value *value);
+
+struct json_value *json_get(const struct json_value *obj, const char *key);
+size_t json_count(const struct json_value *array);
+
+const char *json_get_string(const struct json_value *obj, const char *key,
+			    const char *def);
+long long json_get_int(const struct json_value *obj, const char *key,
+		       long long def);
+double json_get_double(const struct json_value *obj, const char *key,
+		       double def);
+bool json_get_bool(const struct json_value *obj, const char *key, bool def);
+char json_get_char(const struct json_value *obj, const char *key);
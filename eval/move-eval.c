@@ -0,0 +1,1208 @@
+/* move-eval: replays move source and move value filters from a scene
+ * collection snippet against a list of trigger events, without libobs,
+ * and writes the per-frame values as csv.
+ *
+ * usage: move-eval <input.json> [output.csv] [--bench | --soak]
+ *        move-eval --bench-audio
+ *
+ * --soak replays the events over and over for ten simulated minutes without
+ * writing rows, and fails when the runs after the first one keep
+ * allocating or leave anything allocated.
+ *
+ * --bench-audio times the level measurement the audio move filter runs per
+ * captured audio callback next to a plain C port of the work obs_volmeter
+ * does per callback, with sample and with true peak.
+ *
+ * The input is a json object:
+ *   fps                  frames per second (default 60)
+ *   length               milliseconds to simulate (default 5000)
+ *   transition_duration  used by filters without custom duration (300)
+ *   canvas               {width, height} of the scene (1920x1080)
+ *   source               name of the source the filters are on ("source")
+ *   items                scene items bottom to top: {name, pos, rot, scale,
+ *                        bounds, crop, visible}
+ *   values               {target: {setting: value}} start values for the
+ *                        move value filters, numbers or text
+ *   filters              filters as saved in a scene collection:
+ *                        {id, name, settings}, the keyframes of a move
+ *                        source filter take keyframe_time, easing_match,
+ *                        easing_function_match and a transform like items
+ *   events               {time, filter, action} with action start or stop
+ */
+
+#include "../move-transform.h"
+#include "../move-value.h"
+#include "eval-json.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* these mirror the ids in move-transition.h */
+#define MOVE_SOURCE_FILTER_ID "move_source_filter"
+#define MOVE_VALUE_FILTER_ID "move_value_filter"
+#define MOVE_AUDIO_VALUE_FILTER_ID "move_audio_value_filter"
+
+#define EVAL_MOVE_SOURCE 0
+#define EVAL_MOVE_VALUE 1
+
+#define EVAL_TEXT_SIZE 256
+
+struct eval_item {
+	const char *name;
+	struct move_transform transform;
+	bool visible;
+};
+
+/* a setting of a move value target, text settings keep their text */
+struct eval_value {
+	const char *target;
+	const char *name;
+	double value;
+	bool text_set;
+	char *text;
+	size_t text_size;
+};
+
+struct eval_setting {
+	size_t value;
+	long long value_type;
+	double from;
+	double to;
+};
+
+struct eval_filter {
+	const char *name;
+	int kind;
+	const struct json_value *settings;
+
+	bool custom_duration;
+	uint64_t duration;
+	uint64_t start_delay;
+	uint64_t end_delay;
+	long long easing;
+	long long easing_function;
+	const char *simultaneous_move_name;
+	const char *next_move_name;
+	long long next_move_on;
+	bool moving;
+	bool reverse;
+	float running_duration;
+
+	struct eval_item *item;
+	bool transform;
+	struct move_path path;
+	struct move_keyframe *keyframes;
+	size_t keyframes_count;
+	struct move_keyframe *points;
+	long long change_visibility;
+	bool visibility_toggled;
+	long long change_order;
+	long long order_position;
+
+	const char *target;
+	long long move_value_type;
+	long long value_type;
+	int color_space;
+	size_t value;
+	double value_from;
+	double value_to;
+	struct eval_setting *value_settings;
+	size_t value_settings_count;
+
+	long long format_type;
+	const char *format;
+	int decimals;
+	const char *text_to;
+	long long typing_step;
+	char *text_from;
+	size_t text_from_size;
+	char *text_buffer;
+	size_t text_buffer_size;
+	struct move_typing typing;
+	size_t text_step;
+};
+
+struct eval_event {
+	double time;
+	size_t index;
+	struct eval_filter *filter;
+	bool start;
+};
+
+struct eval {
+	FILE *out;
+	bool bench;
+	long long frame;
+	double time;
+	uint64_t transition_duration;
+	uint32_t canvas_width;
+	uint32_t canvas_height;
+	const char *source;
+
+	struct eval_item **items;
+	size_t items_count;
+	struct eval_value *values;
+	size_t values_count;
+	size_t values_capacity;
+	struct eval_filter *filters;
+	size_t filters_count;
+	struct eval_event *events;
+	size_t events_count;
+	unsigned long long rows;
+};
+
+/* the text buffers the ticks write to, counted so --soak can tell whether
+ * they keep allocating or leak */
+static unsigned long long eval_allocations;
+static long long eval_live_blocks;
+
+/* grows *buffer to hold at least size bytes, never shrinks it */
+static void eval_reserve(char **buffer, size_t *capacity, size_t size)
+{
+	if (size <= *capacity)
+		return;
+	if (size < EVAL_TEXT_SIZE)
+		size = EVAL_TEXT_SIZE;
+	char *grown = realloc(*buffer, size);
+	if (!grown) {
+		fprintf(stderr, "out of memory\n");
+		exit(1);
+	}
+	if (!*buffer)
+		eval_live_blocks++;
+	eval_allocations++;
+	*buffer = grown;
+	*capacity = size;
+}
+
+static void eval_release(char *buffer)
+{
+	if (!buffer)
+		return;
+	eval_live_blocks--;
+	free(buffer);
+}
+
+static void eval_row(struct eval *e, const char *filter, const char *target,
+		     const char *property, double value)
+{
+	e->rows++;
+	if (e->bench)
+		return;
+	fprintf(e->out, "%lld,%.3f,%s,%s,%s,%.9g\n", e->frame, e->time, filter,
+		target, property, value);
+}
+
+/* text values are quoted as csv */
+static void eval_row_text(struct eval *e, const char *filter,
+			  const char *target, const char *property,
+			  const char *text)
+{
+	e->rows++;
+	if (e->bench)
+		return;
+	fprintf(e->out, "%lld,%.3f,%s,%s,%s,\"", e->frame, e->time, filter,
+		target, property);
+	for (const char *c = text; *c; c++) {
+		if (*c == '"')
+			fputc('"', e->out);
+		fputc(*c, e->out);
+	}
+	fputs("\"\n", e->out);
+}
+
+static struct eval_filter *eval_find_filter(struct eval *e, const char *name)
+{
+	for (size_t i = 0; i < e->filters_count; i++) {
+		if (strcmp(e->filters[i].name, name) == 0)
+			return &e->filters[i];
+	}
+	return NULL;
+}
+
+static struct eval_item *eval_find_item(struct eval *e, const char *name)
+{
+	for (size_t i = 0; i < e->items_count; i++) {
+		if (strcmp(e->items[i]->name, name) == 0)
+			return e->items[i];
+	}
+	return NULL;
+}
+
+static size_t eval_value_index(struct eval *e, const char *target,
+			       const char *name)
+{
+	for (size_t i = 0; i < e->values_count; i++) {
+		if (strcmp(e->values[i].target, target) == 0 &&
+		    strcmp(e->values[i].name, name) == 0)
+			return i;
+	}
+	if (e->values_count == e->values_capacity) {
+		e->values_capacity = e->values_capacity ? e->values_capacity * 2
+							: 16;
+		e->values = realloc(e->values, e->values_capacity *
+						       sizeof(struct eval_value));
+		if (!e->values) {
+			fprintf(stderr, "out of memory\n");
+			exit(1);
+		}
+	}
+	struct eval_value *v = &e->values[e->values_count];
+	v->target = target;
+	v->name = name;
+	v->value = 0.0;
+	v->text_set = false;
+	v->text = NULL;
+	v->text_size = 0;
+	return e->values_count++;
+}
+
+static void load_transform(const struct json_value *obj,
+			   struct move_transform *transform)
+{
+	const struct json_value *pos = json_get(obj, "pos");
+	const struct json_value *scale = json_get(obj, "scale");
+	const struct json_value *bounds = json_get(obj, "bounds");
+	const struct json_value *crop = json_get(obj, "crop");
+	transform->pos_x = (float)json_get_double(pos, "x", 0.0);
+	transform->pos_y = (float)json_get_double(pos, "y", 0.0);
+	transform->rot = (float)json_get_double(obj, "rot", 0.0);
+	transform->scale_x = (float)json_get_double(scale, "x", 1.0);
+	transform->scale_y = (float)json_get_double(scale, "y", 1.0);
+	transform->bounds_x = (float)json_get_double(bounds, "x", 0.0);
+	transform->bounds_y = (float)json_get_double(bounds, "y", 0.0);
+	transform->crop_left = (int)json_get_int(crop, "left", 0);
+	transform->crop_top = (int)json_get_int(crop, "top", 0);
+	transform->crop_right = (int)json_get_int(crop, "right", 0);
+	transform->crop_bottom = (int)json_get_int(crop, "bottom", 0);
+}
+
+static void calc_relative_to(struct eval_filter *f)
+{
+	const struct json_value *s = f->settings;
+	const struct json_value *pos = json_get(s, "pos");
+	const struct json_value *scale = json_get(s, "scale");
+	const struct json_value *bounds = json_get(s, "bounds");
+	const struct json_value *crop = json_get(s, "crop");
+	const struct move_transform *from = &f->path.from;
+	struct move_transform *to = &f->path.to;
+
+	to->rot = calc_sign(json_get_char(s, "rot_sign"), from->rot,
+			    (float)json_get_double(s, "rot", 0.0));
+	to->pos_x = calc_sign(json_get_char(pos, "x_sign"), from->pos_x,
+			      (float)json_get_double(pos, "x", 0.0));
+	to->pos_y = calc_sign(json_get_char(pos, "y_sign"), from->pos_y,
+			      (float)json_get_double(pos, "y", 0.0));
+	to->scale_x = calc_sign(json_get_char(scale, "x_sign"), from->scale_x,
+				(float)json_get_double(scale, "x", 1.0));
+	to->scale_y = calc_sign(json_get_char(scale, "y_sign"), from->scale_y,
+				(float)json_get_double(scale, "y", 1.0));
+	to->bounds_x = calc_sign(json_get_char(bounds, "x_sign"),
+				 from->bounds_x,
+				 (float)json_get_double(bounds, "x", 0.0));
+	to->bounds_y = calc_sign(json_get_char(bounds, "y_sign"),
+				 from->bounds_y,
+				 (float)json_get_double(bounds, "y", 0.0));
+	to->crop_left = (int)calc_sign(json_get_char(crop, "left_sign"),
+				       (float)from->crop_left,
+				       (float)json_get_int(crop, "left", 0));
+	to->crop_top = (int)calc_sign(json_get_char(crop, "top_sign"),
+				      (float)from->crop_top,
+				      (float)json_get_int(crop, "top", 0));
+	to->crop_right = (int)calc_sign(json_get_char(crop, "right_sign"),
+					(float)from->crop_right,
+					(float)json_get_int(crop, "right", 0));
+	to->crop_bottom =
+		(int)calc_sign(json_get_char(crop, "bottom_sign"),
+			       (float)from->crop_bottom,
+			       (float)json_get_int(crop, "bottom", 0));
+}
+
+static void eval_set_visible(struct eval *e, struct eval_filter *f,
+			     bool visible)
+{
+	if (f->item->visible == visible)
+		return;
+	f->item->visible = visible;
+	eval_row(e, f->name, f->item->name, "visible", visible ? 1.0 : 0.0);
+}
+
+static void eval_change_order(struct eval *e, struct eval_filter *f)
+{
+	size_t index = 0;
+	while (e->items[index] != f->item)
+		index++;
+	size_t new_index = index;
+	if ((f->change_order & CHANGE_ORDER_RELATIVE) != 0 &&
+	    f->order_position) {
+		long long p = (long long)index + f->order_position;
+		if (p < 0)
+			p = 0;
+		if (p >= (long long)e->items_count)
+			p = (long long)e->items_count - 1;
+		new_index = (size_t)p;
+	} else if ((f->change_order & CHANGE_ORDER_ABSOLUTE) != 0) {
+		long long p = f->order_position;
+		if (p < 0)
+			p = 0;
+		if (p >= (long long)e->items_count)
+			p = (long long)e->items_count - 1;
+		new_index = (size_t)p;
+	}
+	if (new_index == index)
+		return;
+	struct eval_item *item = e->items[index];
+	if (new_index > index) {
+		memmove(&e->items[index], &e->items[index + 1],
+			(new_index - index) * sizeof(struct eval_item *));
+	} else {
+		memmove(&e->items[new_index + 1], &e->items[new_index],
+			(index - new_index) * sizeof(struct eval_item *));
+	}
+	e->items[new_index] = item;
+	eval_row(e, f->name, item->name, "order", (double)new_index);
+}
+
+static void eval_value_copy_text(struct eval_value *v, const char *text)
+{
+	const size_t len = strlen(text);
+	eval_reserve(&v->text, &v->text_size, len + 1);
+	memcpy(v->text, text, len + 1);
+	v->text_set = true;
+}
+
+/* like the move value filter, a setting is only written when it changes */
+static void eval_value_set(struct eval *e, struct eval_filter *f,
+			   struct eval_value *v, double value)
+{
+	if (!v->text_set && v->value == value)
+		return;
+	v->text_set = false;
+	v->value = value;
+	eval_row(e, f->name, v->target, v->name, value);
+}
+
+static void eval_value_set_text(struct eval *e, struct eval_filter *f,
+				struct eval_value *v, const char *text)
+{
+	if (v->text_set && strcmp(v->text, text) == 0)
+		return;
+	eval_value_copy_text(v, text);
+	eval_row_text(e, f->name, v->target, v->name, text);
+}
+
+static void eval_typing_start(struct eval_filter *f, const char *text_from)
+{
+	const size_t len = strlen(text_from);
+	eval_reserve(&f->text_from, &f->text_from_size, len + 1);
+	memcpy(f->text_from, text_from, len + 1);
+	move_typing_init(&f->typing, f->text_from, f->text_to);
+	f->text_step = 0;
+	const size_t size = (f->typing.from_len > f->typing.to_len
+				     ? f->typing.from_len
+				     : f->typing.to_len) +
+			    1;
+	eval_reserve(&f->text_buffer, &f->text_buffer_size, size);
+}
+
+static void eval_value_start(struct eval *e, struct eval_filter *f)
+{
+	const struct json_value *s = f->settings;
+	if (f->move_value_type == MOVE_VALUE_TYPE_SETTINGS) {
+		for (size_t i = 0; i < f->value_settings_count; i++) {
+			struct eval_setting *setting = &f->value_settings[i];
+			setting->from = e->values[setting->value].value;
+			setting->to = json_get_double(
+				s, e->values[setting->value].name, 0.0);
+		}
+		return;
+	}
+	const struct eval_value *v = &e->values[f->value];
+	f->value_from = v->value;
+	if (f->value_type == MOVE_VALUE_INT) {
+		if (f->move_value_type == MOVE_VALUE_TYPE_RANDOM) {
+			f->value_to = (double)rand_between(
+				json_get_int(s, "setting_int_min", 0),
+				json_get_int(s, "setting_int_max", 0));
+		} else if (f->move_value_type == MOVE_VALUE_TYPE_SETTING_ADD) {
+			f->value_to = (double)((long long)f->value_from +
+					       json_get_int(s, "setting_int",
+							    0));
+		} else {
+			f->value_to = (double)json_get_int(s, "setting_int", 0);
+		}
+		return;
+	}
+	if (f->value_type == MOVE_VALUE_COLOR) {
+		f->value_to = (double)(uint32_t)json_get_int(s, "setting_color",
+							     0);
+		return;
+	}
+	if (f->value_type == MOVE_VALUE_TEXT) {
+		const char *text_from = v->text_set ? v->text : "";
+		f->value_from =
+			move_value_parse(f->format_type, f->format, text_from);
+		if (f->move_value_type == MOVE_VALUE_TYPE_TYPING)
+			eval_typing_start(f, text_from);
+	}
+	if (f->move_value_type == MOVE_VALUE_TYPE_RANDOM) {
+		f->value_to = rand_between_double(
+			json_get_double(s, "setting_float_min", 0.0),
+			json_get_double(s, "setting_float_max", 0.0));
+	} else if (f->move_value_type == MOVE_VALUE_TYPE_SETTING_ADD) {
+		f->value_to = f->value_from +
+			      json_get_double(s, "setting_float", 0.0);
+	} else {
+		f->value_to = json_get_double(s, "setting_float", 0.0);
+	}
+}
+
+static void eval_filter_start(struct eval *e, struct eval_filter *f)
+{
+	if (f->kind == EVAL_MOVE_SOURCE && !f->item)
+		return;
+	if (!f->custom_duration)
+		f->duration = e->transition_duration;
+	if (f->moving) {
+		if (f->next_move_on == NEXT_MOVE_ON_HOTKEY &&
+		    strcmp(f->next_move_name, NEXT_MOVE_REVERSE) == 0) {
+			f->reverse = !f->reverse;
+			f->running_duration = move_timing_turn(
+				f->running_duration, f->duration,
+				f->start_delay, f->end_delay);
+		}
+		return;
+	}
+	f->running_duration = 0.0f;
+	f->moving = true;
+	eval_row(e, f->name, "", "moving", 1.0);
+
+	if (strlen(f->simultaneous_move_name) &&
+	    strcmp(f->name, f->simultaneous_move_name) != 0) {
+		struct eval_filter *filter =
+			eval_find_filter(e, f->simultaneous_move_name);
+		if (filter)
+			eval_filter_start(e, filter);
+	}
+
+	if (f->kind == EVAL_MOVE_VALUE) {
+		if (!f->reverse)
+			eval_value_start(e, f);
+		return;
+	}
+	if ((f->change_order & CHANGE_ORDER_START) != 0)
+		eval_change_order(e, f);
+	eval_set_visible(e, f,
+			 move_visibility_start(f->change_visibility,
+					       f->item->visible,
+					       &f->visibility_toggled));
+	if (!f->reverse) {
+		f->path.from = f->item->transform;
+		calc_relative_to(f);
+		f->path.points = f->points;
+		f->path.count = move_path_build(&f->path, f->points,
+						f->keyframes,
+						f->keyframes_count,
+						(float)f->duration);
+		move_path_prepare(&f->path);
+	}
+}
+
+static void eval_filter_ended(struct eval *e, struct eval_filter *f)
+{
+	eval_row(e, f->name, "", "moving", 0.0);
+	if (f->next_move_on == NEXT_MOVE_ON_END && strlen(f->next_move_name) &&
+	    strcmp(f->name, f->next_move_name) != 0) {
+		if (strcmp(f->next_move_name, NEXT_MOVE_REVERSE) == 0) {
+			f->reverse = !f->reverse;
+			if (f->reverse)
+				eval_filter_start(e, f);
+		} else {
+			struct eval_filter *filter =
+				eval_find_filter(e, f->next_move_name);
+			if (filter)
+				eval_filter_start(e, filter);
+		}
+	} else if (f->next_move_on == NEXT_MOVE_ON_HOTKEY &&
+		   strcmp(f->next_move_name, NEXT_MOVE_REVERSE) == 0) {
+		f->reverse = !f->reverse;
+	}
+	if (f->kind != EVAL_MOVE_SOURCE)
+		return;
+	eval_set_visible(e, f,
+			 move_visibility_end(f->change_visibility,
+					     f->item->visible,
+					     f->visibility_toggled));
+	if ((f->change_order & CHANGE_ORDER_END) != 0)
+		eval_change_order(e, f);
+}
+
+static void eval_source_tick(struct eval *e, struct eval_filter *f, float t)
+{
+	const uint32_t mask = f->transform ? f->path.change_mask : 0;
+	const float progress =
+		move_timing_progress(f->running_duration, f->duration,
+				     f->start_delay, f->end_delay, f->reverse);
+	struct move_transform *tr = &f->item->transform;
+	move_path_transform(&f->path, mask, t, progress, (float)f->duration,
+			    tr);
+
+	const char *n = f->item->name;
+	if (mask & CHANGE_POS) {
+		eval_row(e, f->name, n, "pos_x", tr->pos_x);
+		eval_row(e, f->name, n, "pos_y", tr->pos_y);
+	}
+	if (mask & CHANGE_ROT)
+		eval_row(e, f->name, n, "rot", tr->rot);
+	if (mask & CHANGE_SCALE) {
+		eval_row(e, f->name, n, "scale_x", tr->scale_x);
+		eval_row(e, f->name, n, "scale_y", tr->scale_y);
+	}
+	if (mask & CHANGE_BOUNDS) {
+		eval_row(e, f->name, n, "bounds_x", tr->bounds_x);
+		eval_row(e, f->name, n, "bounds_y", tr->bounds_y);
+	}
+	if (mask & CHANGE_CROP) {
+		eval_row(e, f->name, n, "crop_left", tr->crop_left);
+		eval_row(e, f->name, n, "crop_top", tr->crop_top);
+		eval_row(e, f->name, n, "crop_right", tr->crop_right);
+		eval_row(e, f->name, n, "crop_bottom", tr->crop_bottom);
+	}
+}
+
+static double eval_lerp_value(long long value_type, int color_space,
+			      double from, double to, float t)
+{
+	if (value_type == MOVE_VALUE_INT)
+		return (double)(long long)move_value_lerp(from, to, t);
+	if (value_type == MOVE_VALUE_COLOR)
+		return (double)move_color_lerp((uint32_t)from, (uint32_t)to, t,
+					       color_space);
+	return move_value_lerp(from, to, t);
+}
+
+static void eval_text_tick(struct eval *e, struct eval_filter *f,
+			   struct eval_value *v, float t)
+{
+	if (f->move_value_type != MOVE_VALUE_TYPE_TYPING) {
+		char text[EVAL_TEXT_SIZE];
+		move_value_format(text, EVAL_TEXT_SIZE, f->format_type,
+				  f->format, f->decimals,
+				  move_value_lerp(f->value_from, f->value_to,
+						  t));
+		eval_value_set_text(e, f, v, text);
+		return;
+	}
+	const size_t step = move_typing_step(&f->typing, t, f->text_step,
+					     f->typing_step, f->reverse,
+					     f->moving);
+	if (!f->text_buffer || step == f->text_step)
+		return;
+	f->text_step = step;
+	const char *src;
+	const size_t len = move_typing_text(&f->typing, step, &src);
+	memcpy(f->text_buffer, src, len);
+	f->text_buffer[len] = '\0';
+	eval_value_set_text(e, f, v, f->text_buffer);
+}
+
+static void eval_value_tick(struct eval *e, struct eval_filter *f, float t)
+{
+	if (f->move_value_type == MOVE_VALUE_TYPE_SETTINGS) {
+		for (size_t i = 0; i < f->value_settings_count; i++) {
+			struct eval_setting *s = &f->value_settings[i];
+			eval_value_set(e, f, &e->values[s->value],
+				       eval_lerp_value(s->value_type,
+						       f->color_space, s->from,
+						       s->to, t));
+		}
+		return;
+	}
+	struct eval_value *v = &e->values[f->value];
+	if (f->value_type == MOVE_VALUE_TEXT) {
+		eval_text_tick(e, f, v, t);
+		return;
+	}
+	eval_value_set(e, f, v,
+		       eval_lerp_value(f->value_type, f->color_space,
+				       f->value_from, f->value_to, t));
+}
+
+static void eval_filter_tick(struct eval *e, struct eval_filter *f,
+			     float seconds)
+{
+	if (!f->moving)
+		return;
+	if (!f->duration) {
+		f->moving = false;
+		return;
+	}
+	float t;
+	bool ended;
+	if (!move_timing_step(&f->running_duration, f->duration,
+			      f->start_delay, f->end_delay, f->reverse,
+			      f->easing, f->easing_function, seconds, &t,
+			      &ended))
+		return;
+	if (ended)
+		f->moving = false;
+	if (f->kind == EVAL_MOVE_SOURCE)
+		eval_source_tick(e, f, t);
+	else
+		eval_value_tick(e, f, t);
+	if (!f->moving)
+		eval_filter_ended(e, f);
+}
+
+static void eval_load_keyframes(struct eval_filter *f,
+				const struct json_value *array)
+{
+	f->keyframes_count = json_count(array);
+	f->keyframes =
+		calloc(f->keyframes_count + 1, sizeof(struct move_keyframe));
+	f->points =
+		calloc(f->keyframes_count + 2, sizeof(struct move_keyframe));
+	size_t i = 0;
+	for (const struct json_value *item = array ? array->child : NULL; item;
+	     item = item->next) {
+		struct move_keyframe *keyframe = &f->keyframes[i++];
+		keyframe->time =
+			(float)json_get_double(item, "keyframe_time", 0.0);
+		keyframe->easing =
+			json_get_int(item, "easing_match", EASE_NONE);
+		keyframe->easing_function = json_get_int(
+			item, "easing_function_match", EASING_CUBIC);
+		load_transform(item, &keyframe->transform);
+	}
+	move_keyframes_sort(f->keyframes, f->keyframes_count);
+}
+
+static bool eval_load_filter(struct eval *e, struct eval_filter *f,
+			     const struct json_value *obj)
+{
+	const char *id = json_get_string(obj, "id", "");
+	if (strcmp(id, MOVE_SOURCE_FILTER_ID) == 0) {
+		f->kind = EVAL_MOVE_SOURCE;
+	} else if (strcmp(id, MOVE_VALUE_FILTER_ID) == 0 ||
+		   strcmp(id, MOVE_AUDIO_VALUE_FILTER_ID) == 0) {
+		f->kind = EVAL_MOVE_VALUE;
+	} else {
+		return false;
+	}
+	const struct json_value *s = json_get(obj, "settings");
+	f->name = json_get_string(obj, "name", "");
+	f->settings = s;
+	f->custom_duration = json_get_bool(s, "custom_duration", true);
+	f->duration = (uint64_t)json_get_int(s, "duration", 300);
+	f->start_delay = (uint64_t)json_get_int(s, "start_delay", 0);
+	f->end_delay = (uint64_t)json_get_int(s, "end_delay", 0);
+	f->easing = json_get_int(s, "easing_match", EASE_IN_OUT);
+	f->easing_function =
+		json_get_int(s, "easing_function_match", EASING_CUBIC);
+	f->simultaneous_move_name =
+		json_get_string(s, "simultaneous_move", "");
+	f->next_move_name = json_get_string(s, "next_move", "");
+	f->next_move_on = json_get_int(s, "next_move_on", NEXT_MOVE_ON_END);
+
+	if (f->kind == EVAL_MOVE_SOURCE) {
+		f->item = eval_find_item(e, json_get_string(s, "source", ""));
+		f->transform = json_get_bool(s, "transform", true);
+		f->path.curve = (float)json_get_double(s, "curve_match", 0.0);
+		f->path.curve_arc_length =
+			json_get_bool(s, "curve_arc_length", false);
+		f->path.canvas_width = e->canvas_width;
+		f->path.canvas_height = e->canvas_height;
+		f->path.keyframe_path = json_get_int(s, "keyframe_path",
+						     KEYFRAME_PATH_LINEAR);
+		f->path.easing = f->easing;
+		f->path.easing_function = f->easing_function;
+		eval_load_keyframes(f, json_get(s, "keyframes"));
+		f->change_visibility = json_get_int(s, "change_visibility", 0);
+		f->change_order = json_get_int(s, "change_order", 0);
+		f->order_position = json_get_int(s, "order_position", 0);
+		return true;
+	}
+
+	const char *filter = json_get_string(s, "filter", "");
+	f->target = strlen(filter) ? filter : e->source;
+	f->move_value_type = json_get_int(s, "move_value_type",
+					  json_get_bool(s, "single_setting",
+							true)
+						  ? MOVE_VALUE_TYPE_SINGLE_SETTING
+						  : MOVE_VALUE_TYPE_SETTINGS);
+	f->value_type = json_get_int(s, "value_type", MOVE_VALUE_FLOAT);
+	f->color_space = (int)json_get_int(s, "color_interpolation",
+					   MOVE_COLOR_LINEAR);
+	f->format_type = json_get_int(s, "setting_format_type",
+				      MOVE_VALUE_FORMAT_DECIMALS);
+	f->format = json_get_string(s, "setting_format", "");
+	if (!strlen(f->format) && f->format_type == MOVE_VALUE_FORMAT_FLOAT)
+		f->format = "%f";
+	else if (!strlen(f->format) &&
+		 f->format_type == MOVE_VALUE_FORMAT_TIME)
+		f->format = "%X";
+	f->decimals = (int)json_get_int(s, "setting_decimals", 0);
+	f->text_to = json_get_string(s, "setting_text", "");
+	f->typing_step = json_get_int(s, "typing_step", 0);
+	if (f->typing_step < 0)
+		f->typing_step = 0;
+	if (f->move_value_type != MOVE_VALUE_TYPE_SETTINGS) {
+		f->value = eval_value_index(
+			e, f->target, json_get_string(s, "setting_name", ""));
+		return true;
+	}
+	const struct json_value *array = json_get(s, "settings");
+	f->value_settings_count = json_count(array);
+	f->value_settings = calloc(f->value_settings_count + 1,
+				   sizeof(struct eval_setting));
+	size_t i = 0;
+	for (const struct json_value *item = array ? array->child : NULL; item;
+	     item = item->next) {
+		struct eval_setting *setting = &f->value_settings[i++];
+		setting->value = eval_value_index(
+			e, f->target, json_get_string(item, "setting_name", ""));
+		setting->value_type =
+			json_get_int(item, "value_type", MOVE_VALUE_FLOAT);
+	}
+	return true;
+}
+
+static int eval_event_compare(const void *a, const void *b)
+{
+	const struct eval_event *ea = a;
+	const struct eval_event *eb = b;
+	if (ea->time != eb->time)
+		return ea->time < eb->time ? -1 : 1;
+	return ea->index < eb->index ? -1 : (ea->index > eb->index ? 1 : 0);
+}
+
+static bool eval_load(struct eval *e, const struct json_value *root)
+{
+	const struct json_value *canvas = json_get(root, "canvas");
+	e->canvas_width = (uint32_t)json_get_int(canvas, "width", 1920);
+	e->canvas_height = (uint32_t)json_get_int(canvas, "height", 1080);
+	e->transition_duration =
+		(uint64_t)json_get_int(root, "transition_duration", 300);
+	e->source = json_get_string(root, "source", "source");
+
+	const struct json_value *items = json_get(root, "items");
+	e->items_count = json_count(items);
+	e->items = calloc(e->items_count + 1, sizeof(struct eval_item *));
+	size_t i = 0;
+	for (const struct json_value *v = items ? items->child : NULL; v;
+	     v = v->next) {
+		struct eval_item *item = calloc(1, sizeof(struct eval_item));
+		item->name = json_get_string(v, "name", "");
+		item->visible = json_get_bool(v, "visible", true);
+		load_transform(v, &item->transform);
+		e->items[i++] = item;
+	}
+
+	const struct json_value *values = json_get(root, "values");
+	for (const struct json_value *target =
+		     values && values->type == JSON_OBJECT ? values->child
+							   : NULL;
+	     target; target = target->next) {
+		if (target->type != JSON_OBJECT)
+			continue;
+		for (const struct json_value *v = target->child; v;
+		     v = v->next) {
+			const size_t index =
+				eval_value_index(e, target->key, v->key);
+			if (v->type == JSON_NUMBER)
+				e->values[index].value = v->number;
+			else if (v->type == JSON_STRING)
+				eval_value_copy_text(&e->values[index],
+						     v->string);
+		}
+	}
+
+	const struct json_value *filters = json_get(root, "filters");
+	e->filters = calloc(json_count(filters) + 1, sizeof(struct eval_filter));
+	for (const struct json_value *v = filters ? filters->child : NULL; v;
+	     v = v->next) {
+		if (eval_load_filter(e, &e->filters[e->filters_count], v))
+			e->filters_count++;
+		else
+			fprintf(stderr, "skipping filter '%s' of type '%s'\n",
+				json_get_string(v, "name", ""),
+				json_get_string(v, "id", ""));
+	}
+
+	const struct json_value *events = json_get(root, "events");
+	e->events = calloc(json_count(events) + 1, sizeof(struct eval_event));
+	for (const struct json_value *v = events ? events->child : NULL; v;
+	     v = v->next) {
+		const char *name = json_get_string(v, "filter", "");
+		const char *action = json_get_string(v, "action", "start");
+		struct eval_event *event = &e->events[e->events_count];
+		event->filter = eval_find_filter(e, name);
+		if (!event->filter) {
+			fprintf(stderr, "event for unknown filter '%s'\n",
+				name);
+			return false;
+		}
+		if (strcmp(action, "start") == 0) {
+			event->start = true;
+		} else if (strcmp(action, "stop") != 0) {
+			fprintf(stderr, "unknown event action '%s'\n", action);
+			return false;
+		}
+		event->time = json_get_double(v, "time", 0.0);
+		event->index = e->events_count++;
+	}
+	qsort(e->events, e->events_count, sizeof(struct eval_event),
+	      eval_event_compare);
+	return true;
+}
+
+static void eval_free(struct eval *e)
+{
+	for (size_t i = 0; i < e->items_count; i++)
+		free(e->items[i]);
+	for (size_t i = 0; i < e->values_count; i++)
+		eval_release(e->values[i].text);
+	for (size_t i = 0; i < e->filters_count; i++) {
+		free(e->filters[i].value_settings);
+		eval_release(e->filters[i].text_from);
+		eval_release(e->filters[i].text_buffer);
+		free(e->filters[i].keyframes);
+		free(e->filters[i].points);
+	}
+	free(e->items);
+	free(e->values);
+	free(e->filters);
+	free(e->events);
+}
+
+static char *read_file(const char *path)
+{
+	FILE *f = fopen(path, "rb");
+	if (!f)
+		return NULL;
+	fseek(f, 0, SEEK_END);
+	const long size = ftell(f);
+	fseek(f, 0, SEEK_SET);
+	char *text = size >= 0 ? malloc((size_t)size + 1) : NULL;
+	if (text) {
+		const size_t read = fread(text, 1, (size_t)size, f);
+		text[read] = '\0';
+	}
+	fclose(f);
+	return text;
+}
+
+static void eval_filter_stop(struct eval *e, struct eval_filter *f)
+{
+	if (!f->moving)
+		return;
+	f->moving = false;
+	eval_row(e, f->name, "", "moving", 0.0);
+}
+
+/* replays the events over frames + 1 frames from time 0, the frame count
+ * keeps running */
+static void eval_run(struct eval *e, double fps, long long frames)
+{
+	const float seconds = (float)(1.0 / fps);
+	size_t next_event = 0;
+	for (long long frame = 0; frame <= frames; frame++, e->frame++) {
+		e->time = (double)frame * 1000.0 / fps;
+		while (next_event < e->events_count &&
+		       e->events[next_event].time <= e->time) {
+			struct eval_event *event = &e->events[next_event++];
+			if (event->start)
+				eval_filter_start(e, event->filter);
+			else
+				eval_filter_stop(e, event->filter);
+		}
+		for (size_t i = 0; i < e->filters_count; i++)
+			eval_filter_tick(e, &e->filters[i], seconds);
+	}
+}
+
+#define EVAL_SOAK_MINUTES 10
+
+/* Replays the events for ten simulated minutes, stopping every filter after
+ * each run. Fails when a run after the first one still allocates text
+ * buffers or leaves any behind. */
+static int eval_soak(struct eval *e, double fps, long long frames)
+{
+	const double run = (double)(frames + 1) * 1000.0 / fps;
+	const long long runs =
+		(long long)ceil(EVAL_SOAK_MINUTES * 60000.0 / run);
+	unsigned long long allocations = 0;
+	long long live = 0;
+	const clock_t begin = clock();
+	for (long long n = 0; n < runs; n++) {
+		eval_run(e, fps, frames);
+		for (size_t i = 0; i < e->filters_count; i++)
+			eval_filter_stop(e, &e->filters[i]);
+		if (n == 0) {
+			allocations = eval_allocations;
+			live = eval_live_blocks;
+		}
+	}
+	const double elapsed = (double)(clock() - begin) / CLOCKS_PER_SEC;
+	fprintf(stderr, "soak: %lld runs, %lld frames, %llu values in %.3f s\n",
+		runs, e->frame, e->rows, elapsed);
+	fprintf(stderr,
+		"  after the first run: %llu allocations, %lld blocks left\n",
+		eval_allocations - allocations, eval_live_blocks - live);
+	return eval_allocations == allocations && eval_live_blocks == live
+		       ? 0
+		       : 1;
+}
+
+#define BENCH_AUDIO_FRAMES 1024
+#define BENCH_AUDIO_CHANNELS 2
+#define BENCH_AUDIO_CALLBACKS 200000
+
+/* The work obs_volmeter does per audio callback in libobs
+ * obs-audio-controls.c, ported from its SSE code to plain C: magnitude,
+ * sample or 4x oversampled true peak per channel, the conversion of
+ * magnitude, peak and input peak to dB, and the conversion of the one level
+ * the audio move filter uses back with obs_db_to_mul. The locking and
+ * signalling around it are left out, so this is a lower bound. */
+struct bench_volmeter {
+	float prev_samples[BENCH_AUDIO_CHANNELS][4];
+	float magnitude[BENCH_AUDIO_CHANNELS];
+	float peak[BENCH_AUDIO_CHANNELS];
+};
+
+static float bench_mul_to_db(float mul)
+{
+	return mul == 0.0f ? -INFINITY : 20.0f * log10f(mul);
+}
+
+static float bench_db_to_mul(float db)
+{
+	return isfinite((double)db) ? powf(10.0f, db / 20.0f) : 0.0f;
+}
+
+/* normalized sinc weights of the samples at -1.5, -0.5, 0.5 and 1.5 for
+ * the points at -0.3, -0.1, 0.1 and 0.3 between the middle two */
+static const float bench_true_peak_weights[4][4] = {
+	{-0.155915f, 0.935489f, 0.233872f, -0.103943f},
+	{-0.216236f, 0.756827f, 0.504551f, -0.189207f},
+	{-0.189207f, 0.504551f, 0.756827f, -0.216236f},
+	{-0.103943f, 0.233872f, 0.935489f, -0.155915f},
+};
+
+static float bench_true_peak(const float previous[4], const float *samples,
+			     size_t frames)
+{
+	/* a lane per oversampled point, like the four floats of the sse
+	 * register libobs keeps them in */
+	float work[4] = {previous[0], previous[1], previous[2], previous[3]};
+	float peak[4];
+	for (int p = 0; p < 4; p++)
+		peak[p] = fabsf(previous[p]);
+	for (size_t i = 0; i < frames; i++) {
+		const float a = fabsf(samples[i]);
+		peak[0] = a > peak[0] ? a : peak[0];
+		work[0] = work[1];
+		work[1] = work[2];
+		work[2] = work[3];
+		work[3] = samples[i];
+		for (int p = 0; p < 4; p++) {
+			const float *w = bench_true_peak_weights[p];
+			const float v = fabsf(work[0] * w[0] + work[1] * w[1] +
+					      work[2] * w[2] + work[3] * w[3]);
+			peak[p] = v > peak[p] ? v : peak[p];
+		}
+	}
+	return fmaxf(fmaxf(peak[0], peak[1]), fmaxf(peak[2], peak[3]));
+}
+
+/* meter picks the magnitude, peak or input peak array like the volmeter
+ * callback of the filter does */
+static float bench_volmeter_process(struct bench_volmeter *volmeter,
+				    float (*samples)[BENCH_AUDIO_FRAMES],
+				    size_t frames, bool true_peak, float mul,
+				    int meter)
+{
+	for (int c = 0; c < BENCH_AUDIO_CHANNELS; c++) {
+		const float *s = samples[c];
+		float sum = 0.0f;
+		for (size_t i = 0; i < frames; i++)
+			sum += s[i] * s[i];
+		volmeter->magnitude[c] = sqrtf(sum / (float)frames);
+
+		if (true_peak) {
+			volmeter->peak[c] = bench_true_peak(
+				volmeter->prev_samples[c], s, frames);
+		} else {
+			float peak[4] = {0};
+			for (size_t i = 0; i + 3 < frames; i += 4) {
+				for (int lane = 0; lane < 4; lane++) {
+					const float a = fabsf(s[i + lane]);
+					if (a > peak[lane])
+						peak[lane] = a;
+				}
+			}
+			volmeter->peak[c] = fmaxf(fmaxf(peak[0], peak[1]),
+						  fmaxf(peak[2], peak[3]));
+		}
+		for (int i = 0; i < 4; i++)
+			volmeter->prev_samples[c][i] = s[frames - 4 + i];
+	}
+
+	float magnitude[BENCH_AUDIO_CHANNELS];
+	float peak[BENCH_AUDIO_CHANNELS];
+	float input_peak[BENCH_AUDIO_CHANNELS];
+	for (int c = 0; c < BENCH_AUDIO_CHANNELS; c++) {
+		magnitude[c] = bench_mul_to_db(volmeter->magnitude[c] * mul);
+		peak[c] = bench_mul_to_db(volmeter->peak[c] * mul);
+		input_peak[c] = bench_mul_to_db(volmeter->peak[c]);
+	}
+	const float *db = meter == 0 ? magnitude
+			  : meter == 1 ? peak
+				       : input_peak;
+	float level = 0.0f;
+	for (int c = 0; c < BENCH_AUDIO_CHANNELS; c++)
+		level += bench_db_to_mul(db[c]);
+	return level;
+}
+
+static double bench_audio_elapsed(clock_t begin)
+{
+	return (double)(clock() - begin) / CLOCKS_PER_SEC * 1e9 /
+	       BENCH_AUDIO_CALLBACKS;
+}
+
+static int bench_audio(void)
+{
+	static float samples[BENCH_AUDIO_CHANNELS][BENCH_AUDIO_FRAMES];
+	srand(1);
+	for (int c = 0; c < BENCH_AUDIO_CHANNELS; c++)
+		for (int i = 0; i < BENCH_AUDIO_FRAMES; i++)
+			samples[c][i] =
+				(float)rand() / (float)RAND_MAX * 2.0f - 1.0f;
+
+	volatile float sink = 0.0f;
+	clock_t begin = clock();
+	for (int n = 0; n < BENCH_AUDIO_CALLBACKS; n++) {
+		for (int c = 0; c < BENCH_AUDIO_CHANNELS; c++) {
+			float rms;
+			float peak;
+			move_audio_level(samples[c], BENCH_AUDIO_FRAMES, &rms,
+					 &peak);
+			sink += rms + peak;
+		}
+	}
+	const double direct = bench_audio_elapsed(begin);
+
+	struct bench_volmeter volmeter = {0};
+	volatile int meter = 1;
+	begin = clock();
+	for (int n = 0; n < BENCH_AUDIO_CALLBACKS; n++)
+		sink += bench_volmeter_process(&volmeter, samples,
+					       BENCH_AUDIO_FRAMES, false, 0.5f,
+					       meter);
+	const double sample_peak = bench_audio_elapsed(begin);
+
+	begin = clock();
+	for (int n = 0; n < BENCH_AUDIO_CALLBACKS; n++)
+		sink += bench_volmeter_process(&volmeter, samples,
+					       BENCH_AUDIO_FRAMES, true, 0.5f,
+					       meter);
+	const double true_peak = bench_audio_elapsed(begin);
+
+	fprintf(stderr, "per callback of %d x %d frames:\n",
+		BENCH_AUDIO_CHANNELS, BENCH_AUDIO_FRAMES);
+	fprintf(stderr, "  direct capture       %8.0f ns\n", direct);
+	fprintf(stderr, "  volmeter sample peak %8.0f ns (%.1fx)\n",
+		sample_peak, sample_peak / direct);
+	fprintf(stderr, "  volmeter true peak   %8.0f ns (%.1fx)\n", true_peak,
+		true_peak / direct);
+	return sink == 0.0f ? 1 : 0;
+}
+
+int main(int argc, char **argv)
+{
+	const char *input = NULL;
+	const char *output = NULL;
+	struct eval e = {0};
+	bool soak = false;
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "--bench-audio") == 0)
+			return bench_audio();
+		if (strcmp(argv[i], "--bench") == 0) {
+			e.bench = true;
+		} else if (strcmp(argv[i], "--soak") == 0) {
+			/* rows are counted but not written */
+			e.bench = true;
+			soak = true;
+		} else if (!input) {
+			input = argv[i];
+		} else {
+			output = argv[i];
+		}
+	}
+	if (!input) {
+		fprintf(stderr, "usage: move-eval <input.json> [output.csv] "
+				"[--bench | --soak]\n");
+		return 2;
+	}
+	char *text = read_file(input);
+	if (!text) {
+		fprintf(stderr, "could not read '%s'\n", input);
+		return 1;
+	}
+	const char *error = NULL;
+	struct json_value *root = json_parse(text, &error);
+	free(text);
+	if (!root) {
+		fprintf(stderr, "could not parse '%s': %s\n", input, error);
+		return 1;
+	}
+
+	move_color_init();
+	int result = 1;
+	if (!eval_load(&e, root))
+		goto done;
+
+	e.out = output ? fopen(output, "w") : stdout;
+	if (!e.out) {
+		fprintf(stderr, "could not write '%s'\n", output);
+		goto done;
+	}
+	if (!e.bench)
+		fprintf(e.out, "frame,time,filter,target,property,value\n");
+
+	srand((unsigned int)json_get_int(root, "seed", 0));
+	const double fps = json_get_double(root, "fps", 60.0);
+	const double length = json_get_double(root, "length", 5000.0);
+	const long long frames = (long long)(length * fps / 1000.0);
+	if (soak) {
+		result = eval_soak(&e, fps, frames);
+		if (output)
+			fclose(e.out);
+		goto done;
+	}
+
+	const clock_t begin = clock();
+	eval_run(&e, fps, frames);
+	const double elapsed = (double)(clock() - begin) / CLOCKS_PER_SEC;
+
+	if (e.bench) {
+		fprintf(stderr,
+			"%lld frames, %zu filters, %llu values in %.3f s (%.0f frames/s)\n",
+			frames + 1, e.filters_count, e.rows, elapsed,
+			elapsed > 0.0 ? (double)(frames + 1) / elapsed : 0.0);
+	}
+	if (output)
+		fclose(e.out);
+	result = 0;
+done:
+	eval_free(&e);
+	json_free(root);
+	if (soak && eval_live_blocks) {
+		fprintf(stderr, "soak: %lld blocks leaked\n", eval_live_blocks);
+		result = 1;
+	}
+	return result;
+}
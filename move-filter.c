@@ -205,12 +205,10 @@ bool move_filter_start_internal(struct move_filter *move_filter)
 		    strcmp(move_filter->next_move_name, NEXT_MOVE_REVERSE) ==
 			    0) {
 			move_filter->reverse = !move_filter->reverse;
-			move_filter->running_duration =
-				(float)(move_filter->duration +
-					move_filter->start_delay +
-					move_filter->end_delay) /
-					1000.0f -
-				move_filter->running_duration;
+			move_filter->running_duration = move_timing_turn(
+				move_filter->running_duration,
+				move_filter->duration, move_filter->start_delay,
+				move_filter->end_delay);
 		}
 		return false;
 	}
@@ -334,8 +332,6 @@ extern void move_filter_ended(struct move_filter *move_filter)
 	}
 }
 
-float get_eased(float f, long long easing, long long easing_function);
-
 bool move_filter_tick(struct move_filter *move_filter, float seconds, float *tp)
 {
 	const bool enabled = obs_source_enabled(move_filter->source);
@@ -367,29 +363,15 @@ bool move_filter_tick(struct move_filter *move_filter, float seconds, float *tp)
 		return false;
 	}
 
-	move_filter->running_duration += seconds;
-	if (move_filter->running_duration * 1000.0f <
-	    (move_filter->reverse ? move_filter->end_delay
-				  : move_filter->start_delay)) {
+	bool ended;
+	if (!move_timing_step(&move_filter->running_duration,
+			      move_filter->duration, move_filter->start_delay,
+			      move_filter->end_delay, move_filter->reverse,
+			      move_filter->easing, move_filter->easing_function,
+			      seconds, tp, &ended))
 		return false;
-	}
-	if (move_filter->running_duration * 1000.0f >=
-	    (float)(move_filter->start_delay + move_filter->duration +
-		    move_filter->end_delay)) {
+	if (ended)
 		move_filter->moving = false;
-	}
-	float t = (move_filter->running_duration * 1000.0f -
-		   (float)(move_filter->reverse ? move_filter->end_delay
-						: move_filter->start_delay)) /
-		  (float)move_filter->duration;
-	if (t >= 1.0f) {
-		t = 1.0f;
-	}
-	if (move_filter->reverse) {
-		t = 1.0f - t;
-	}
-	t = get_eased(t, move_filter->easing, move_filter->easing_function);
-	*tp = t;
 	return true;
 }
 
@@ -3,6 +3,7 @@
 #include <obs-module.h>
 #include <stdio.h>
 #include <util/dstr.h>
+#include <util/threading.h>
 
 struct move_source_info {
 	struct move_filter move_filter;
@@ -10,21 +11,11 @@ struct move_source_info {
 	char *source_name;
 	obs_sceneitem_t *scene_item;
 
-	float curve;
-
 	bool transform;
-	struct vec2 pos_from;
-	struct vec2 pos_to;
-	float rot_from;
-	float rot_to;
-	struct vec2 scale_from;
-	struct vec2 scale_to;
-	struct vec2 bounds_from;
-	struct vec2 bounds_to;
-	struct obs_sceneitem_crop crop_from;
-	struct obs_sceneitem_crop crop_to;
-	uint32_t canvas_width;
-	uint32_t canvas_height;
+	struct move_path path;
+	DARRAY(struct move_keyframe) keyframes;
+	DARRAY(struct move_keyframe) points;
+	struct move_transform pending;
 
 	long long change_visibility;
 	bool visibility_toggled;
@@ -103,82 +94,117 @@ void obs_data_set_char(obs_data_t *data, const char *name, char val)
 	obs_data_set_string(data, name, s);
 }
 
-float calc_sign(char sign, float from, float to)
-{
-	if (sign == '+') {
-		return from + to;
-	} else if (sign == '-') {
-		return from - to;
-	} else if (sign == '*') {
-		return from * to;
-	} else if (sign == '/') {
-		return to == 0.0f ? from : from / to;
-	} else {
-		return to;
-	}
-}
-
 void calc_relative_to(struct move_source_info *move_source)
 {
 
 	obs_data_t *settings =
 		obs_source_get_settings(move_source->move_filter.source);
+	const struct move_transform *from = &move_source->path.from;
+	struct move_transform *to = &move_source->path.to;
 
-	move_source->rot_to = calc_sign(
-		obs_data_get_char(settings, "rot_sign"), move_source->rot_from,
-		(float)obs_data_get_double(settings, S_ROT));
+	to->rot = calc_sign(obs_data_get_char(settings, "rot_sign"), from->rot,
+			    (float)obs_data_get_double(settings, S_ROT));
 
 	obs_data_t *pos = obs_data_get_obj(settings, S_POS);
-	move_source->pos_to.x = calc_sign(obs_data_get_char(pos, "x_sign"),
-					  move_source->pos_from.x,
-					  (float)obs_data_get_double(pos, "x"));
+	to->pos_x = calc_sign(obs_data_get_char(pos, "x_sign"), from->pos_x,
+			      (float)obs_data_get_double(pos, "x"));
 
-	move_source->pos_to.y = calc_sign(obs_data_get_char(pos, "y_sign"),
-					  move_source->pos_from.y,
-					  (float)obs_data_get_double(pos, "y"));
+	to->pos_y = calc_sign(obs_data_get_char(pos, "y_sign"), from->pos_y,
+			      (float)obs_data_get_double(pos, "y"));
 	obs_data_release(pos);
 
 	obs_data_t *scale = obs_data_get_obj(settings, S_SCALE);
-	move_source->scale_to.x = calc_sign(
-		obs_data_get_char(scale, "x_sign"), move_source->scale_from.x,
-		(float)obs_data_get_double(scale, "x"));
+	to->scale_x = calc_sign(obs_data_get_char(scale, "x_sign"),
+				from->scale_x,
+				(float)obs_data_get_double(scale, "x"));
 
-	move_source->scale_to.y = calc_sign(
-		obs_data_get_char(scale, "y_sign"), move_source->scale_from.y,
-		(float)obs_data_get_double(scale, "y"));
+	to->scale_y = calc_sign(obs_data_get_char(scale, "y_sign"),
+				from->scale_y,
+				(float)obs_data_get_double(scale, "y"));
 	obs_data_release(scale);
 
 	obs_data_t *bounds = obs_data_get_obj(settings, S_BOUNDS);
-	move_source->bounds_to.x = calc_sign(
-		obs_data_get_char(bounds, "x_sign"), move_source->bounds_from.x,
-		(float)obs_data_get_double(bounds, "x"));
+	to->bounds_x = calc_sign(obs_data_get_char(bounds, "x_sign"),
+				 from->bounds_x,
+				 (float)obs_data_get_double(bounds, "x"));
 
-	move_source->bounds_to.y = calc_sign(
-		obs_data_get_char(bounds, "y_sign"), move_source->bounds_from.y,
-		(float)obs_data_get_double(bounds, "y"));
+	to->bounds_y = calc_sign(obs_data_get_char(bounds, "y_sign"),
+				 from->bounds_y,
+				 (float)obs_data_get_double(bounds, "y"));
 	obs_data_release(bounds);
 
 	obs_data_t *crop = obs_data_get_obj(settings, S_CROP);
-	move_source->crop_to.left =
-		(int)calc_sign(obs_data_get_char(crop, "left_sign"),
-			       (float)move_source->crop_from.left,
-			       (float)obs_data_get_int(crop, "left"));
-	move_source->crop_to.top =
-		(int)calc_sign(obs_data_get_char(crop, "top_sign"),
-			       (float)move_source->crop_from.top,
-			       (float)obs_data_get_int(crop, "top"));
-	move_source->crop_to.right =
-		(int)calc_sign(obs_data_get_char(crop, "right_sign"),
-			       (float)move_source->crop_from.right,
-			       (float)obs_data_get_int(crop, "right"));
-	move_source->crop_to.bottom =
+	to->crop_left = (int)calc_sign(obs_data_get_char(crop, "left_sign"),
+				       (float)from->crop_left,
+				       (float)obs_data_get_int(crop, "left"));
+	to->crop_top = (int)calc_sign(obs_data_get_char(crop, "top_sign"),
+				      (float)from->crop_top,
+				      (float)obs_data_get_int(crop, "top"));
+	to->crop_right = (int)calc_sign(obs_data_get_char(crop, "right_sign"),
+					(float)from->crop_right,
+					(float)obs_data_get_int(crop, "right"));
+	to->crop_bottom =
 		(int)calc_sign(obs_data_get_char(crop, "bottom_sign"),
-			       (float)move_source->crop_from.bottom,
+			       (float)from->crop_bottom,
 			       (float)obs_data_get_int(crop, "bottom"));
 	obs_data_release(crop);
 	obs_data_release(settings);
 }
 
+static void move_source_load_keyframes(struct move_source_info *move_source,
+				       obs_data_t *settings)
+{
+	obs_data_array_t *keyframes = obs_data_get_array(settings, S_KEYFRAMES);
+	const size_t count = obs_data_array_count(keyframes);
+	da_resize(move_source->keyframes, count);
+	for (size_t i = 0; i < count; i++) {
+		obs_data_t *item = obs_data_array_item(keyframes, i);
+		struct move_keyframe *keyframe =
+			move_source->keyframes.array + i;
+		struct move_transform *transform = &keyframe->transform;
+		struct vec2 v;
+		keyframe->time = (float)obs_data_get_int(item, S_KEYFRAME_TIME);
+		keyframe->easing = obs_data_get_int(item, S_EASING_MATCH);
+		keyframe->easing_function =
+			obs_data_get_int(item, S_EASING_FUNCTION_MATCH);
+		obs_data_get_vec2(item, S_POS, &v);
+		transform->pos_x = v.x;
+		transform->pos_y = v.y;
+		transform->rot = (float)obs_data_get_double(item, S_ROT);
+		obs_data_get_vec2(item, S_SCALE, &v);
+		transform->scale_x = v.x;
+		transform->scale_y = v.y;
+		obs_data_get_vec2(item, S_BOUNDS, &v);
+		transform->bounds_x = v.x;
+		transform->bounds_y = v.y;
+		obs_data_t *crop = obs_data_get_obj(item, S_CROP);
+		transform->crop_left = (int)obs_data_get_int(crop, "left");
+		transform->crop_top = (int)obs_data_get_int(crop, "top");
+		transform->crop_right = (int)obs_data_get_int(crop, "right");
+		transform->crop_bottom = (int)obs_data_get_int(crop, "bottom");
+		obs_data_release(crop);
+		obs_data_release(item);
+	}
+	obs_data_array_release(keyframes);
+	move_keyframes_sort(move_source->keyframes.array, count);
+}
+
+/* The path runs from the transform at the start of the move through the
+ * keyframes inside the duration to the target transform. */
+static void move_source_build_path(struct move_source_info *move_source)
+{
+	struct move_path *path = &move_source->path;
+	const size_t count = move_source->keyframes.num;
+	path->easing = move_source->move_filter.easing;
+	path->easing_function = move_source->move_filter.easing_function;
+	da_resize(move_source->points, count ? count + 2 : 0);
+	path->points = move_source->points.array;
+	path->count = move_path_build(path, path->points,
+				      move_source->keyframes.array, count,
+				      (float)move_source->move_filter.duration);
+	move_path_prepare(path);
+}
+
 void move_source_media_action(struct move_source_info *move_source,
 			      long long media_action, int64_t media_time)
 {
@@ -277,6 +303,62 @@ void move_source_media_action(struct move_source_info *move_source,
 	}
 }
 
+static void move_source_item_transform(obs_sceneitem_t *item,
+				       struct move_transform *transform)
+{
+	struct vec2 v;
+	struct obs_sceneitem_crop crop;
+	obs_sceneitem_get_pos(item, &v);
+	transform->pos_x = v.x;
+	transform->pos_y = v.y;
+	transform->rot = obs_sceneitem_get_rot(item);
+	obs_sceneitem_get_scale(item, &v);
+	transform->scale_x = v.x;
+	transform->scale_y = v.y;
+	obs_sceneitem_get_bounds(item, &v);
+	transform->bounds_x = v.x;
+	transform->bounds_y = v.y;
+	obs_sceneitem_get_crop(item, &crop);
+	transform->crop_left = crop.left;
+	transform->crop_top = crop.top;
+	transform->crop_right = crop.right;
+	transform->crop_bottom = crop.bottom;
+}
+
+static void move_source_apply(struct move_source_info *move_source,
+			      uint32_t mask)
+{
+	obs_sceneitem_t *item = move_source->scene_item;
+	const struct move_transform *pending = &move_source->pending;
+	if (!mask || !item)
+		return;
+	obs_sceneitem_defer_update_begin(item);
+	if (mask & CHANGE_POS) {
+		struct vec2 pos;
+		vec2_set(&pos, pending->pos_x, pending->pos_y);
+		obs_sceneitem_set_pos(item, &pos);
+	}
+	if (mask & CHANGE_ROT)
+		obs_sceneitem_set_rot(item, pending->rot);
+	if (mask & CHANGE_SCALE) {
+		struct vec2 scale;
+		vec2_set(&scale, pending->scale_x, pending->scale_y);
+		obs_sceneitem_set_scale(item, &scale);
+	}
+	if (mask & CHANGE_BOUNDS) {
+		struct vec2 bounds;
+		vec2_set(&bounds, pending->bounds_x, pending->bounds_y);
+		obs_sceneitem_set_bounds(item, &bounds);
+	}
+	if (mask & CHANGE_CROP) {
+		struct obs_sceneitem_crop crop = {
+			pending->crop_left, pending->crop_top,
+			pending->crop_right, pending->crop_bottom};
+		obs_sceneitem_set_crop(item, &crop);
+	}
+	obs_sceneitem_defer_update_end(item);
+}
+
 void move_source_ended(struct move_source_info *move_source);
 
 void move_source_start(struct move_source_info *move_source)
@@ -323,26 +405,10 @@ void move_source_start(struct move_source_info *move_source)
 				(int)move_source->order_position);
 		}
 	}
-	if ((move_source->change_visibility == CHANGE_VISIBILITY_SHOW_START ||
-	     move_source->change_visibility ==
-		     CHANGE_VISIBILITY_SHOW_START_END ||
-	     move_source->change_visibility == CHANGE_VISIBILITY_TOGGLE) &&
-	    !obs_sceneitem_visible(move_source->scene_item)) {
-		obs_sceneitem_set_visible(move_source->scene_item, true);
-		move_source->visibility_toggled = true;
-	} else {
-		move_source->visibility_toggled = false;
-	}
-	if (move_source->change_visibility == CHANGE_VISIBILITY_TOGGLE_START) {
-		obs_sceneitem_set_visible(
-			move_source->scene_item,
-			!obs_sceneitem_visible(move_source->scene_item));
-	} else if (move_source->change_visibility ==
-			   CHANGE_VISIBILITY_HIDE_START ||
-		   move_source->change_visibility ==
-			   CHANGE_VISIBILITY_HIDE_START_END) {
-		obs_sceneitem_set_visible(move_source->scene_item, false);
-	}
+	const bool visible = obs_sceneitem_visible(move_source->scene_item);
+	if (move_visibility_start(move_source->change_visibility, visible,
+				  &move_source->visibility_toggled) != visible)
+		obs_sceneitem_set_visible(move_source->scene_item, !visible);
 	move_source_media_action(move_source, move_source->media_action_start,
 				 move_source->media_time_start);
 
@@ -363,23 +429,17 @@ void move_source_start(struct move_source_info *move_source)
 	}
 
 	if (!move_source->move_filter.reverse) {
-		move_source->rot_from =
-			obs_sceneitem_get_rot(move_source->scene_item);
-		obs_sceneitem_get_pos(move_source->scene_item,
-				      &move_source->pos_from);
-		obs_sceneitem_get_scale(move_source->scene_item,
-					&move_source->scale_from);
-		obs_sceneitem_get_bounds(move_source->scene_item,
-					 &move_source->bounds_from);
-		obs_sceneitem_get_crop(move_source->scene_item,
-				       &move_source->crop_from);
+		move_source_item_transform(move_source->scene_item,
+					   &move_source->path.from);
 		obs_source_t *scene_source = obs_scene_get_source(
 			obs_sceneitem_get_scene(move_source->scene_item));
-		move_source->canvas_width = obs_source_get_width(scene_source);
-		move_source->canvas_height =
+		move_source->path.canvas_width =
+			obs_source_get_width(scene_source);
+		move_source->path.canvas_height =
 			obs_source_get_height(scene_source);
 
 		calc_relative_to(move_source);
+		move_source_build_path(move_source);
 
 		move_source->audio_fade_from = obs_source_get_volume(
 			obs_sceneitem_get_source(move_source->scene_item));
@@ -607,8 +667,10 @@ void move_source_update(void *data, obs_data_t *settings)
 
 	move_source->change_visibility =
 		obs_data_get_int(settings, S_CHANGE_VISIBILITY);
-	move_source->curve =
+	move_source->path.curve =
 		(float)obs_data_get_double(settings, S_CURVE_MATCH);
+	move_source->path.curve_arc_length =
+		obs_data_get_bool(settings, S_CURVE_ARC_LENGTH);
 
 	move_source->transform = obs_data_get_bool(settings, S_TRANSFORM);
 	if (obs_data_has_user_value(settings, "crop_left") ||
@@ -652,6 +714,10 @@ void move_source_update(void *data, obs_data_t *settings)
 		obs_data_unset_user_value(settings, S_TRANSFORM_RELATIVE);
 	}
 	calc_relative_to(move_source);
+	move_source->path.keyframe_path =
+		obs_data_get_int(settings, S_KEYFRAME_PATH);
+	move_source_load_keyframes(move_source, settings);
+	move_source_build_path(move_source);
 
 	move_source->change_order = obs_data_get_int(settings, S_CHANGE_ORDER);
 	move_source->order_position =
@@ -859,6 +925,8 @@ static void move_source_destroy(void *data)
 		}
 	}
 	move_source->scene_item = NULL;
+	da_free(move_source->keyframes);
+	da_free(move_source->points);
 	move_filter_destroy(&move_source->move_filter);
 	bfree(move_source->source_name);
 	bfree(move_source);
@@ -943,6 +1011,85 @@ bool move_source_get_transform(obs_properties_t *props,
 	return settings_changed;
 }
 
+bool move_source_add_keyframe(obs_properties_t *props,
+			      obs_property_t *property, void *data)
+{
+	UNUSED_PARAMETER(props);
+	UNUSED_PARAMETER(property);
+	struct move_source_info *move_source = data;
+	if (!move_source->scene_item)
+		return false;
+	obs_data_t *settings =
+		obs_source_get_settings(move_source->move_filter.source);
+	const long long time = obs_data_get_int(settings, S_KEYFRAME_TIME);
+
+	obs_data_t *keyframe = obs_data_create();
+	obs_data_set_int(keyframe, S_KEYFRAME_TIME, time);
+	obs_data_set_int(keyframe, S_EASING_MATCH,
+			 obs_data_get_int(settings, S_KEYFRAME_EASING));
+	obs_data_set_int(keyframe, S_EASING_FUNCTION_MATCH,
+			 obs_data_get_int(settings,
+					  S_KEYFRAME_EASING_FUNCTION));
+	struct vec2 v;
+	obs_sceneitem_get_pos(move_source->scene_item, &v);
+	obs_data_set_vec2(keyframe, S_POS, &v);
+	obs_data_set_double(keyframe, S_ROT,
+			    obs_sceneitem_get_rot(move_source->scene_item));
+	obs_sceneitem_get_scale(move_source->scene_item, &v);
+	obs_data_set_vec2(keyframe, S_SCALE, &v);
+	obs_sceneitem_get_bounds(move_source->scene_item, &v);
+	obs_data_set_vec2(keyframe, S_BOUNDS, &v);
+	struct obs_sceneitem_crop crop;
+	obs_sceneitem_get_crop(move_source->scene_item, &crop);
+	obs_data_t *obj = obs_data_create();
+	obs_data_set_int(obj, "left", crop.left);
+	obs_data_set_int(obj, "top", crop.top);
+	obs_data_set_int(obj, "right", crop.right);
+	obs_data_set_int(obj, "bottom", crop.bottom);
+	obs_data_set_obj(keyframe, S_CROP, obj);
+	obs_data_release(obj);
+
+	obs_data_array_t *keyframes = obs_data_get_array(settings, S_KEYFRAMES);
+	if (!keyframes) {
+		keyframes = obs_data_array_create();
+		obs_data_set_array(settings, S_KEYFRAMES, keyframes);
+	}
+	size_t index = 0;
+	const size_t count = obs_data_array_count(keyframes);
+	while (index < count) {
+		obs_data_t *item = obs_data_array_item(keyframes, index);
+		const long long item_time =
+			obs_data_get_int(item, S_KEYFRAME_TIME);
+		obs_data_release(item);
+		if (item_time == time)
+			obs_data_array_erase(keyframes, index);
+		if (item_time >= time)
+			break;
+		index++;
+	}
+	obs_data_array_insert(keyframes, index, keyframe);
+	obs_data_array_release(keyframes);
+	obs_data_release(keyframe);
+
+	move_source_update(data, settings);
+	obs_data_release(settings);
+	return true;
+}
+
+bool move_source_clear_keyframes(obs_properties_t *props,
+				 obs_property_t *property, void *data)
+{
+	UNUSED_PARAMETER(props);
+	UNUSED_PARAMETER(property);
+	struct move_source_info *move_source = data;
+	obs_data_t *settings =
+		obs_source_get_settings(move_source->move_filter.source);
+	obs_data_erase(settings, S_KEYFRAMES);
+	move_source_update(data, settings);
+	obs_data_release(settings);
+	return true;
+}
+
 bool move_source_relative(obs_properties_t *props, obs_property_t *property,
 			  void *data)
 {
@@ -1231,6 +1378,34 @@ static obs_properties_t *move_source_properties(void *data)
 	obs_properties_add_float_slider(group, S_CURVE_MATCH,
 					obs_module_text("Curve"), -2.0, 2.0,
 					0.01);
+	obs_properties_add_bool(group, S_CURVE_ARC_LENGTH,
+				obs_module_text("CurveArcLength"));
+
+	p = obs_properties_add_list(group, S_KEYFRAME_PATH,
+				    obs_module_text("KeyframePath"),
+				    OBS_COMBO_TYPE_LIST, OBS_COMBO_FORMAT_INT);
+	obs_property_list_add_int(p, obs_module_text("KeyframePath.Linear"),
+				  KEYFRAME_PATH_LINEAR);
+	obs_property_list_add_int(p, obs_module_text("KeyframePath.Smooth"),
+				  KEYFRAME_PATH_SMOOTH);
+	p = obs_properties_add_int(group, S_KEYFRAME_TIME,
+				   obs_module_text("KeyframeTime"), 0, 10000000,
+				   100);
+	obs_property_int_set_suffix(p, "ms");
+	p = obs_properties_add_list(group, S_KEYFRAME_EASING,
+				    obs_module_text("KeyframeEasing"),
+				    OBS_COMBO_TYPE_LIST, OBS_COMBO_FORMAT_INT);
+	prop_list_add_easings(p);
+	p = obs_properties_add_list(group, S_KEYFRAME_EASING_FUNCTION,
+				    obs_module_text("KeyframeEasingFunction"),
+				    OBS_COMBO_TYPE_LIST, OBS_COMBO_FORMAT_INT);
+	prop_list_add_easing_functions(p);
+	obs_properties_add_button(group, "keyframe_add",
+				  obs_module_text("AddKeyframe"),
+				  move_source_add_keyframe);
+	obs_properties_add_button(group, "keyframe_clear",
+				  obs_module_text("ClearKeyframes"),
+				  move_source_clear_keyframes);
 
 	p = obs_properties_add_group(ppts, S_TRANSFORM,
 				     obs_module_text("Transform"),
@@ -1499,30 +1674,13 @@ static const char *move_source_get_name(void *type_data)
 	return obs_module_text("MoveSourceFilter");
 }
 
-void vec2_bezier(struct vec2 *dst, struct vec2 *begin, struct vec2 *control,
-		 struct vec2 *end, const float t);
-
 void move_source_ended(struct move_source_info *move_source)
 {
 	move_filter_ended(&move_source->move_filter);
-	if (move_source->change_visibility == CHANGE_VISIBILITY_HIDE_END ||
-	    move_source->change_visibility ==
-		    CHANGE_VISIBILITY_SHOW_START_END) {
-		obs_sceneitem_set_visible(move_source->scene_item, false);
-	} else if (move_source->change_visibility ==
-			   CHANGE_VISIBILITY_SHOW_END ||
-		   move_source->change_visibility ==
-			   CHANGE_VISIBILITY_HIDE_START_END) {
-		obs_sceneitem_set_visible(move_source->scene_item, true);
-	} else if (move_source->change_visibility ==
-		   CHANGE_VISIBILITY_TOGGLE_END) {
-		obs_sceneitem_set_visible(
-			move_source->scene_item,
-			!obs_sceneitem_visible(move_source->scene_item));
-	} else if (move_source->change_visibility == CHANGE_VISIBILITY_TOGGLE &&
-		   !move_source->visibility_toggled) {
-		obs_sceneitem_set_visible(move_source->scene_item, false);
-	}
+	const bool visible = obs_sceneitem_visible(move_source->scene_item);
+	if (move_visibility_end(move_source->change_visibility, visible,
+				move_source->visibility_toggled) != visible)
+		obs_sceneitem_set_visible(move_source->scene_item, !visible);
 	move_source_media_action(move_source, move_source->media_action_end,
 				 move_source->media_time_end);
 	if ((move_source->mute_action == MUTE_ACTION_MUTE_END ||
@@ -1592,78 +1750,20 @@ void move_source_tick(void *data, float seconds)
 			(1.0f - ot) * move_source->audio_fade_from +
 				ot * move_source->audio_fade_to);
 	}
-	if (move_source->transform) {
-		struct vec2 pos;
-		if (move_source->curve != 0.0f) {
-			const float diff_x = fabsf(move_source->pos_from.x -
-						   move_source->pos_to.x);
-			const float diff_y = fabsf(move_source->pos_from.y -
-						   move_source->pos_to.y);
-			struct vec2 control_pos;
-			vec2_set(&control_pos,
-				 0.5f * move_source->pos_from.x +
-					 0.5f * move_source->pos_to.x,
-				 0.5f * move_source->pos_from.y +
-					 0.5f * move_source->pos_to.y);
-			if (control_pos.x >= (move_source->canvas_width >> 1)) {
-				control_pos.x += diff_y * move_source->curve;
-			} else {
-				control_pos.x -= diff_y * move_source->curve;
-			}
-			if (control_pos.y >=
-			    (move_source->canvas_height >> 1)) {
-				control_pos.y += diff_x * move_source->curve;
-			} else {
-				control_pos.y -= diff_x * move_source->curve;
-			}
-			vec2_bezier(&pos, &move_source->pos_from, &control_pos,
-				    &move_source->pos_to, t);
-		} else {
-			vec2_set(&pos,
-				 (1.0f - t) * move_source->pos_from.x +
-					 t * move_source->pos_to.x,
-				 (1.0f - t) * move_source->pos_from.y +
-					 t * move_source->pos_to.y);
-		}
-		obs_sceneitem_defer_update_begin(move_source->scene_item);
-		obs_sceneitem_set_pos(move_source->scene_item, &pos);
-		const float rot = (1.0f - t) * move_source->rot_from +
-				  t * move_source->rot_to;
-		obs_sceneitem_set_rot(move_source->scene_item, rot);
-		struct vec2 scale;
-		vec2_set(&scale,
-			 (1.0f - t) * move_source->scale_from.x +
-				 t * move_source->scale_to.x,
-			 (1.0f - t) * move_source->scale_from.y +
-				 t * move_source->scale_to.y);
-		obs_sceneitem_set_scale(move_source->scene_item, &scale);
-		struct vec2 bounds;
-		vec2_set(&bounds,
-			 (1.0f - t) * move_source->bounds_from.x +
-				 t * move_source->bounds_to.x,
-			 (1.0f - t) * move_source->bounds_from.y +
-				 t * move_source->bounds_to.y);
-		obs_sceneitem_set_bounds(move_source->scene_item, &bounds);
-		struct obs_sceneitem_crop crop;
-		crop.left = (int)((float)(1.0f - ot) *
-					  (float)move_source->crop_from.left +
-				  ot * (float)move_source->crop_to.left);
-		crop.top = (int)((float)(1.0f - ot) *
-					 (float)move_source->crop_from.top +
-				 ot * (float)move_source->crop_to.top);
-		crop.right = (int)((float)(1.0f - ot) *
-					   (float)move_source->crop_from.right +
-				   ot * (float)move_source->crop_to.right);
-		crop.bottom =
-			(int)((float)(1.0f - ot) *
-				      (float)move_source->crop_from.bottom +
-			      ot * (float)move_source->crop_to.bottom);
-		obs_sceneitem_set_crop(move_source->scene_item, &crop);
-		obs_sceneitem_defer_update_end(move_source->scene_item);
-	}
-	if (!move_source->move_filter.moving) {
+	const struct move_filter *move_filter = &move_source->move_filter;
+	const uint32_t change_mask =
+		move_source->transform ? move_source->path.change_mask : 0;
+	const float progress = move_timing_progress(
+		move_filter->running_duration, move_filter->duration,
+		move_filter->start_delay, move_filter->end_delay,
+		move_filter->reverse);
+	move_path_transform(&move_source->path, change_mask, t, progress,
+			    (float)move_filter->duration,
+			    &move_source->pending);
+	move_source_apply(move_source, change_mask);
+
+	if (!move_source->move_filter.moving)
 		move_source_ended(move_source);
-	}
 }
 
 struct obs_source_info move_source_filter = {
@@ -0,0 +1,576 @@
+#include "move-timeline.h"
+#include <math.h>
+#include "easing.h"
+
+float get_eased(float f, long long easing, long long easing_function)
+{
+	float t = f;
+	if (EASE_NONE == easing) {
+	} else if (EASE_IN == easing) {
+		switch (easing_function) {
+		case EASING_QUADRATIC:
+			t = QuadraticEaseIn(f);
+			break;
+		case EASING_CUBIC:
+			t = CubicEaseIn(f);
+			break;
+		case EASING_QUARTIC:
+			t = QuarticEaseIn(f);
+			break;
+		case EASING_QUINTIC:
+			t = QuinticEaseIn(f);
+			break;
+		case EASING_SINE:
+			t = SineEaseIn(f);
+			break;
+		case EASING_CIRCULAR:
+			t = CircularEaseIn(f);
+			break;
+		case EASING_EXPONENTIAL:
+			t = ExponentialEaseIn(f);
+			break;
+		case EASING_ELASTIC:
+			t = ElasticEaseIn(f);
+			break;
+		case EASING_BOUNCE:
+			t = BounceEaseIn(f);
+			break;
+		case EASING_BACK:
+			t = BackEaseIn(f);
+			break;
+		default:;
+		}
+	} else if (EASE_OUT == easing) {
+		switch (easing_function) {
+		case EASING_QUADRATIC:
+			t = QuadraticEaseOut(f);
+			break;
+		case EASING_CUBIC:
+			t = CubicEaseOut(f);
+			break;
+		case EASING_QUARTIC:
+			t = QuarticEaseOut(f);
+			break;
+		case EASING_QUINTIC:
+			t = QuinticEaseOut(f);
+			break;
+		case EASING_SINE:
+			t = SineEaseOut(f);
+			break;
+		case EASING_CIRCULAR:
+			t = CircularEaseOut(f);
+			break;
+		case EASING_EXPONENTIAL:
+			t = ExponentialEaseOut(f);
+			break;
+		case EASING_ELASTIC:
+			t = ElasticEaseOut(f);
+			break;
+		case EASING_BOUNCE:
+			t = BounceEaseOut(f);
+			break;
+		case EASING_BACK:
+			t = BackEaseOut(f);
+			break;
+		default:;
+		}
+	} else if (EASE_IN_OUT == easing) {
+		switch (easing_function) {
+		case EASING_QUADRATIC:
+			t = QuadraticEaseInOut(f);
+			break;
+		case EASING_CUBIC:
+			t = CubicEaseInOut(f);
+			break;
+		case EASING_QUARTIC:
+			t = QuarticEaseInOut(f);
+			break;
+		case EASING_QUINTIC:
+			t = QuinticEaseInOut(f);
+			break;
+		case EASING_SINE:
+			t = SineEaseInOut(f);
+			break;
+		case EASING_CIRCULAR:
+			t = CircularEaseInOut(f);
+			break;
+		case EASING_EXPONENTIAL:
+			t = ExponentialEaseInOut(f);
+			break;
+		case EASING_ELASTIC:
+			t = ElasticEaseInOut(f);
+			break;
+		case EASING_BOUNCE:
+			t = BounceEaseInOut(f);
+			break;
+		case EASING_BACK:
+			t = BackEaseInOut(f);
+			break;
+		default:;
+		}
+	}
+	return t;
+}
+
+bool move_timing_step(float *running_duration, uint64_t duration,
+		      uint64_t start_delay, uint64_t end_delay, bool reverse,
+		      long long easing, long long easing_function,
+		      float seconds, float *tp, bool *ended)
+{
+	*running_duration += seconds;
+	*ended = false;
+	if (*running_duration * 1000.0f <
+	    (reverse ? end_delay : start_delay)) {
+		return false;
+	}
+	if (*running_duration * 1000.0f >=
+	    (float)(start_delay + duration + end_delay)) {
+		*ended = true;
+	}
+	const float t = move_timing_progress(*running_duration, duration,
+					     start_delay, end_delay, reverse);
+	*tp = get_eased(t, easing, easing_function);
+	return true;
+}
+
+float move_timing_progress(float running_duration, uint64_t duration,
+			   uint64_t start_delay, uint64_t end_delay,
+			   bool reverse)
+{
+	if (!duration)
+		return reverse ? 0.0f : 1.0f;
+	float t = (running_duration * 1000.0f -
+		   (float)(reverse ? end_delay : start_delay)) /
+		  (float)duration;
+	if (t >= 1.0f) {
+		t = 1.0f;
+	} else if (t < 0.0f) {
+		t = 0.0f;
+	}
+	if (reverse) {
+		t = 1.0f - t;
+	}
+	return t;
+}
+
+float move_timing_turn(float running_duration, uint64_t duration,
+		       uint64_t start_delay, uint64_t end_delay)
+{
+	return (float)(duration + start_delay + end_delay) / 1000.0f -
+	       running_duration;
+}
+
+bool move_visibility_start(long long change_visibility, bool visible,
+			   bool *toggled)
+{
+	*toggled = false;
+	switch (change_visibility) {
+	case CHANGE_VISIBILITY_SHOW_START:
+	case CHANGE_VISIBILITY_SHOW_START_END:
+	case CHANGE_VISIBILITY_TOGGLE:
+		*toggled = !visible;
+		return true;
+	case CHANGE_VISIBILITY_TOGGLE_START:
+		return !visible;
+	case CHANGE_VISIBILITY_HIDE_START:
+	case CHANGE_VISIBILITY_HIDE_START_END:
+		return false;
+	}
+	return visible;
+}
+
+bool move_visibility_end(long long change_visibility, bool visible,
+			 bool toggled)
+{
+	switch (change_visibility) {
+	case CHANGE_VISIBILITY_HIDE_END:
+	case CHANGE_VISIBILITY_SHOW_START_END:
+		return false;
+	case CHANGE_VISIBILITY_SHOW_END:
+	case CHANGE_VISIBILITY_HIDE_START_END:
+		return true;
+	case CHANGE_VISIBILITY_TOGGLE_END:
+		return !visible;
+	case CHANGE_VISIBILITY_TOGGLE:
+		return toggled ? visible : false;
+	}
+	return visible;
+}
+
+float calc_sign(char sign, float from, float to)
+{
+	if (sign == '+') {
+		return from + to;
+	} else if (sign == '-') {
+		return from - to;
+	} else if (sign == '*') {
+		return from * to;
+	} else if (sign == '/') {
+		return to == 0.0f ? from : from / to;
+	} else {
+		return to;
+	}
+}
+
+float bezier(float point[], float t, int order)
+{
+	if (order < 1)
+		return point[0];
+	/* bernstein form evaluated horner style, no recursion */
+	const float u = 1.0f - t;
+	float tn = 1.0f;
+	float binomial = 1.0f;
+	float result = point[0] * u;
+	for (int i = 1; i < order; i++) {
+		tn *= t;
+		binomial = binomial * (float)(order - i + 1) / (float)i;
+		result = (result + tn * binomial * point[i]) * u;
+	}
+	return result + tn * t * point[order];
+}
+
+void move_arc_length_init(struct move_arc_length *table, float x[3],
+			  float y[3])
+{
+	float prev_x = x[0];
+	float prev_y = y[0];
+	float length = 0.0f;
+	table->length[0] = 0.0f;
+	for (int i = 1; i <= MOVE_ARC_LENGTH_SAMPLES; i++) {
+		const float t = (float)i / (float)MOVE_ARC_LENGTH_SAMPLES;
+		const float px = bezier(x, t, 2);
+		const float py = bezier(y, t, 2);
+		length += sqrtf((px - prev_x) * (px - prev_x) +
+				(py - prev_y) * (py - prev_y));
+		table->length[i] = length;
+		prev_x = px;
+		prev_y = py;
+	}
+}
+
+float move_arc_length_t(const struct move_arc_length *table, float t)
+{
+	const float total = table->length[MOVE_ARC_LENGTH_SAMPLES];
+	if (t <= 0.0f || t >= 1.0f || total <= 0.0f)
+		return t;
+	const float target = t * total;
+	int low = 0;
+	int high = MOVE_ARC_LENGTH_SAMPLES;
+	while (high - low > 1) {
+		const int mid = (low + high) / 2;
+		if (table->length[mid] <= target)
+			low = mid;
+		else
+			high = mid;
+	}
+	const float segment = table->length[high] - table->length[low];
+	const float f = segment > 0.0f
+				? (target - table->length[low]) / segment
+				: 0.0f;
+	return ((float)low + f) / (float)MOVE_ARC_LENGTH_SAMPLES;
+}
+
+float catmull_rom(float p0, float p1, float p2, float p3, float t)
+{
+	const float t2 = t * t;
+	const float t3 = t2 * t;
+	return 0.5f * (2.0f * p1 + (p2 - p0) * t +
+		       (2.0f * p0 - 5.0f * p1 + 4.0f * p2 - p3) * t2 +
+		       (3.0f * p1 - p0 - 3.0f * p2 + p3) * t3);
+}
+
+void move_curve_control(float from_x, float from_y, float to_x, float to_y,
+			float curve, uint32_t canvas_width,
+			uint32_t canvas_height, float *control_x,
+			float *control_y)
+{
+	const float diff_x = fabsf(from_x - to_x);
+	const float diff_y = fabsf(from_y - to_y);
+	*control_x = 0.5f * from_x + 0.5f * to_x;
+	*control_y = 0.5f * from_y + 0.5f * to_y;
+	if (*control_x >= (canvas_width >> 1)) {
+		*control_x += diff_y * curve;
+	} else {
+		*control_x -= diff_y * curve;
+	}
+	if (*control_y >= (canvas_height >> 1)) {
+		*control_y += diff_x * curve;
+	} else {
+		*control_y -= diff_x * curve;
+	}
+}
+
+float move_srgb_nonlinear_to_linear(float u)
+{
+	return (u <= 0.04045f) ? (u / 12.92f)
+			       : powf((u + 0.055f) / 1.055f, 2.4f);
+}
+
+float move_srgb_linear_to_nonlinear(float u)
+{
+	return (u <= 0.0031308f) ? (12.92f * u)
+				 : ((1.055f * powf(u, 1.0f / 2.4f)) - 0.055f);
+}
+
+#define MOVE_SRGB_TABLE_SIZE 4096
+
+/* The encode truncates to 8 bits like vec4_to_rgba does. The table holds the
+ * byte at the start of each bucket of linear values, the thresholds the
+ * smallest linear value of each byte. A bucket never spans more than one
+ * threshold, so one compare makes the lookup exact. */
+static uint8_t move_srgb_table[MOVE_SRGB_TABLE_SIZE + 1];
+static float move_srgb_threshold[257];
+
+static uint32_t move_srgb_encode_exact(float v)
+{
+	return (uint32_t)((double)move_srgb_linear_to_nonlinear(v) * 255.0);
+}
+
+void move_color_init(void)
+{
+	/* bisect the float bits, which are ordered like the values */
+	move_srgb_threshold[0] = 0.0f;
+	for (uint32_t c = 1; c < 256; c++) {
+		float low = move_srgb_threshold[c - 1];
+		float high = 1.0f;
+		while (true) {
+			const float mid = low + (high - low) * 0.5f;
+			if (mid <= low || mid >= high)
+				break;
+			if (move_srgb_encode_exact(mid) >= c)
+				high = mid;
+			else
+				low = mid;
+		}
+		move_srgb_threshold[c] = high;
+	}
+	move_srgb_threshold[256] = 2.0f;
+	for (int i = 0; i <= MOVE_SRGB_TABLE_SIZE; i++)
+		move_srgb_table[i] = (uint8_t)move_srgb_encode_exact(
+			(float)i / (float)MOVE_SRGB_TABLE_SIZE);
+}
+
+static inline float move_color_clamp(float v)
+{
+	/* also maps NaN to 0 */
+	return fminf(fmaxf(v, 0.0f), 1.0f);
+}
+
+static inline uint32_t move_srgb_encode(float v)
+{
+	v = move_color_clamp(v);
+	const uint32_t c =
+		move_srgb_table[(int)(v * (float)MOVE_SRGB_TABLE_SIZE)];
+	return c + (uint32_t)(v >= move_srgb_threshold[c + 1]);
+}
+
+void move_color_from_linear(const float linear[4], int space, float out[4])
+{
+	if (space != MOVE_COLOR_OKLAB) {
+		for (int i = 0; i < 4; i++)
+			out[i] = linear[i];
+		return;
+	}
+	const float r = linear[0];
+	const float g = linear[1];
+	const float b = linear[2];
+	const float l = cbrtf(0.4122214708f * r + 0.5363325363f * g +
+			      0.0514459929f * b);
+	const float m = cbrtf(0.2119034982f * r + 0.6806995451f * g +
+			      0.1073969566f * b);
+	const float s = cbrtf(0.0883024619f * r + 0.2817188376f * g +
+			      0.6299787005f * b);
+	out[0] = 0.2104542553f * l + 0.7936177850f * m - 0.0040720468f * s;
+	out[1] = 1.9779984951f * l - 2.4285922050f * m + 0.4505937099f * s;
+	out[2] = 0.0259040371f * l + 0.7827717662f * m - 0.8086757660f * s;
+	out[3] = linear[3];
+}
+
+void move_color_decode(uint32_t rgba, int space, float out[4])
+{
+	float linear[4];
+	for (int i = 0; i < 4; i++) {
+		const float v = (float)((rgba >> (i * 8)) & 0xFF) / 255.0f;
+		linear[i] = i < 3 ? move_srgb_nonlinear_to_linear(v) : v;
+	}
+	move_color_from_linear(linear, space, out);
+}
+
+static void move_color_oklab_to_linear(float (*colors)[4], size_t count)
+{
+	for (size_t i = 0; i < count; i++) {
+		float *color = colors[i];
+		float l = color[0] + 0.3963377774f * color[1] +
+			  0.2158037573f * color[2];
+		float m = color[0] - 0.1055613458f * color[1] -
+			  0.0638541728f * color[2];
+		float s = color[0] - 0.0894841775f * color[1] -
+			  1.2914855480f * color[2];
+		l = l * l * l;
+		m = m * m * m;
+		s = s * s * s;
+		color[0] = 4.0767416621f * l - 3.3077115913f * m +
+			   0.2309699292f * s;
+		color[1] = -1.2684380046f * l + 2.6097574011f * m -
+			   0.3413193965f * s;
+		color[2] = -0.0041960863f * l - 0.7034186147f * m +
+			   1.7076147010f * s;
+	}
+}
+
+static void move_color_pack(const float (*colors)[4], size_t count,
+			    uint32_t *out)
+{
+	for (size_t i = 0; i < count; i++) {
+		const float *color = colors[i];
+		out[i] = move_srgb_encode(color[0]) |
+			 move_srgb_encode(color[1]) << 8 |
+			 move_srgb_encode(color[2]) << 16 |
+			 (uint32_t)(move_color_clamp(color[3]) * 255.0f) << 24;
+	}
+}
+
+uint32_t move_color_encode(const float color[4], int space)
+{
+	float colors[1][4] = {{color[0], color[1], color[2], color[3]}};
+	uint32_t rgba;
+	if (space == MOVE_COLOR_OKLAB)
+		move_color_oklab_to_linear(colors, 1);
+	move_color_pack((const float(*)[4])colors, 1, &rgba);
+	return rgba;
+}
+
+#define MOVE_COLOR_CHUNK 64
+
+void move_color_lerp_batch(const struct move_color_track *tracks,
+			   size_t count, float t, int space, uint32_t *out)
+{
+	/* Every pass runs over a chunk of tracks without branches in the
+	 * loop body, the lerp and oklab passes are plain float math for the
+	 * compiler to vectorize, so it builds the same on every architecture
+	 * obs supports. Only the table lookups of the pack stay scalar. */
+	float colors[MOVE_COLOR_CHUNK][4];
+	for (size_t base = 0; base < count; base += MOVE_COLOR_CHUNK) {
+		const size_t n = count - base < MOVE_COLOR_CHUNK
+					 ? count - base
+					 : MOVE_COLOR_CHUNK;
+		const struct move_color_track *chunk = tracks + base;
+		for (size_t i = 0; i < n; i++) {
+			for (int c = 0; c < 4; c++)
+				colors[i][c] = chunk[i].from[c] +
+					       (chunk[i].to[c] -
+						chunk[i].from[c]) *
+						       t;
+		}
+		if (space == MOVE_COLOR_OKLAB)
+			move_color_oklab_to_linear(colors, n);
+		move_color_pack((const float(*)[4])colors, n, out + base);
+	}
+}
+
+uint32_t move_color_lerp(uint32_t from, uint32_t to, float t, int space)
+{
+	struct move_color_track track;
+	uint32_t rgba;
+	move_color_decode(from, space, track.from);
+	move_color_decode(to, space, track.to);
+	move_color_lerp_batch(&track, 1, t, space, &rgba);
+	return rgba;
+}
+
+#define MOVE_AUDIO_LANES 8
+
+void move_audio_level(const float *samples, size_t frames, float *rms,
+		      float *peak)
+{
+	/* independent lanes so the compiler can keep them in vector
+	 * registers */
+	float sum[MOVE_AUDIO_LANES] = {0};
+	float max[MOVE_AUDIO_LANES] = {0};
+	size_t i = 0;
+	for (; i + MOVE_AUDIO_LANES <= frames; i += MOVE_AUDIO_LANES) {
+		for (int lane = 0; lane < MOVE_AUDIO_LANES; lane++) {
+			const float s = samples[i + lane];
+			const float a = fabsf(s);
+			sum[lane] += s * s;
+			max[lane] = a > max[lane] ? a : max[lane];
+		}
+	}
+	for (; i < frames; i++) {
+		const float a = fabsf(samples[i]);
+		sum[0] += a * a;
+		max[0] = a > max[0] ? a : max[0];
+	}
+	float total = 0.0f;
+	float top = 0.0f;
+	for (int lane = 0; lane < MOVE_AUDIO_LANES; lane++) {
+		total += sum[lane];
+		top = max[lane] > top ? max[lane] : top;
+	}
+	*rms = frames ? sqrtf(total / (float)frames) : 0.0f;
+	*peak = top;
+}
+
+void move_fft_init(struct move_fft *fft)
+{
+	const double pi = 3.14159265358979323846;
+	double power = 0.0;
+	for (int n = 0; n < MOVE_FFT_SIZE; n++) {
+		const double w = 0.5 - 0.5 * cos(2.0 * pi * n / MOVE_FFT_SIZE);
+		fft->window[n] = (float)w;
+		power += w * w;
+		int r = 0;
+		for (int b = 0; b < MOVE_FFT_BITS; b++)
+			r |= ((n >> b) & 1) << (MOVE_FFT_BITS - 1 - b);
+		fft->reverse[n] = (uint16_t)r;
+	}
+	/* parseval: half the spectrum of a windowed sine holds
+	 * size * power * amplitude^2 / 4 */
+	fft->scale = (float)(2.0 / (MOVE_FFT_SIZE * power));
+	for (int k = 0; k < MOVE_FFT_SIZE / 2; k++) {
+		fft->cos[k] = (float)cos(2.0 * pi * k / MOVE_FFT_SIZE);
+		fft->sin[k] = (float)sin(2.0 * pi * k / MOVE_FFT_SIZE);
+	}
+}
+
+float move_fft_band_level(struct move_fft *fft, const float *history,
+			  size_t start, float low, float high)
+{
+	for (size_t n = 0; n < MOVE_FFT_SIZE; n++) {
+		const size_t i = fft->reverse[n];
+		fft->re[i] = history[(start + n) % MOVE_FFT_SIZE] *
+			     fft->window[n];
+		fft->im[i] = 0.0f;
+	}
+	for (size_t size = 2; size <= MOVE_FFT_SIZE; size <<= 1) {
+		const size_t half = size / 2;
+		const size_t step = MOVE_FFT_SIZE / size;
+		for (size_t i = 0; i < MOVE_FFT_SIZE; i += size) {
+			for (size_t j = 0; j < half; j++) {
+				const float c = fft->cos[j * step];
+				const float s = fft->sin[j * step];
+				const size_t a = i + j;
+				const size_t b = a + half;
+				const float tr =
+					fft->re[b] * c + fft->im[b] * s;
+				const float ti =
+					fft->im[b] * c - fft->re[b] * s;
+				fft->re[b] = fft->re[a] - tr;
+				fft->im[b] = fft->im[a] - ti;
+				fft->re[a] += tr;
+				fft->im[a] += ti;
+			}
+		}
+	}
+
+	long first = (long)ceilf(low * MOVE_FFT_SIZE);
+	long last = (long)floorf(high * MOVE_FFT_SIZE);
+	if (first < 0)
+		first = 0;
+	if (last > MOVE_FFT_SIZE / 2)
+		last = MOVE_FFT_SIZE / 2;
+	float energy = 0.0f;
+	for (long k = first; k <= last; k++)
+		energy += fft->re[k] * fft->re[k] + fft->im[k] * fft->im[k];
+	return sqrtf(energy * fft->scale);
+}
@@ -0,0 +1,164 @@
+#pragma once
+
+/* Timing, interpolation and level math shared by the move filters and the
+ * headless move-eval tool. Nothing in here may depend on libobs. */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define EASE_NONE 0
+#define EASE_IN 1
+#define EASE_OUT 2
+#define EASE_IN_OUT 3
+
+#define EASING_QUADRATIC 1
+#define EASING_CUBIC 2
+#define EASING_QUARTIC 3
+#define EASING_QUINTIC 4
+#define EASING_SINE 5
+#define EASING_CIRCULAR 6
+#define EASING_EXPONENTIAL 7
+#define EASING_ELASTIC 8
+#define EASING_BOUNCE 9
+#define EASING_BACK 10
+
+#define NEXT_MOVE_ON_END 0
+#define NEXT_MOVE_ON_HOTKEY 1
+#define NEXT_MOVE_REVERSE "Reverse"
+
+#define CHANGE_VISIBILITY_NONE 0
+#define CHANGE_VISIBILITY_SHOW_START 1
+#define CHANGE_VISIBILITY_HIDE_END 2
+#define CHANGE_VISIBILITY_TOGGLE 3
+#define CHANGE_VISIBILITY_SHOW_END 4
+#define CHANGE_VISIBILITY_HIDE_START 5
+#define CHANGE_VISIBILITY_TOGGLE_START 6
+#define CHANGE_VISIBILITY_TOGGLE_END 7
+#define CHANGE_VISIBILITY_SHOW_START_END 8
+#define CHANGE_VISIBILITY_HIDE_START_END 9
+
+#define CHANGE_ORDER_NONE 0
+#define CHANGE_ORDER_RELATIVE (1 << 0)
+#define CHANGE_ORDER_ABSOLUTE (1 << 1)
+#define CHANGE_ORDER_START (1 << 2)
+#define CHANGE_ORDER_END (1 << 3)
+
+float get_eased(float f, long long easing, long long easing_function);
+
+/* Advances *running_duration by seconds. Returns false while the move is
+ * still waiting on its start delay, otherwise stores the eased progress in
+ * *tp. *ended is set once start delay, duration and end delay have passed. */
+bool move_timing_step(float *running_duration, uint64_t duration,
+		      uint64_t start_delay, uint64_t end_delay, bool reverse,
+		      long long easing, long long easing_function,
+		      float seconds, float *tp, bool *ended);
+
+/* linear progress of the move in [0..1] before easing, reversed for a
+ * reverse move */
+float move_timing_progress(float running_duration, uint64_t duration,
+			   uint64_t start_delay, uint64_t end_delay,
+			   bool reverse);
+
+/* running duration after a running move turns around, so it goes back from
+ * where it is */
+float move_timing_turn(float running_duration, uint64_t duration,
+		       uint64_t start_delay, uint64_t end_delay);
+
+/* visibility of the moved item at the start of the move, *toggled is set
+ * when it was only shown for the move */
+bool move_visibility_start(long long change_visibility, bool visible,
+			   bool *toggled);
+/* visibility of the moved item at the end of the move */
+bool move_visibility_end(long long change_visibility, bool visible,
+			 bool toggled);
+
+float calc_sign(char sign, float from, float to);
+float bezier(float point[], float t, int order);
+
+/* cumulative length of a quadratic bezier at evenly spaced t, used to move
+ * along the curve at constant speed */
+#define MOVE_ARC_LENGTH_SAMPLES 16
+
+struct move_arc_length {
+	float length[MOVE_ARC_LENGTH_SAMPLES + 1];
+};
+
+void move_arc_length_init(struct move_arc_length *table, float x[3],
+			  float y[3]);
+/* maps the fraction of the path length to the bezier t */
+float move_arc_length_t(const struct move_arc_length *table, float t);
+
+/* uniform catmull-rom spline, passes through p1 at t 0 and p2 at t 1 */
+float catmull_rom(float p0, float p1, float p2, float p3, float t);
+
+/* control point of the curved path between from and to, bent away from the
+ * canvas center by curve */
+void move_curve_control(float from_x, float from_y, float to_x, float to_y,
+			float curve, uint32_t canvas_width,
+			uint32_t canvas_height, float *control_x,
+			float *control_y);
+
+float move_srgb_nonlinear_to_linear(float u);
+float move_srgb_linear_to_nonlinear(float u);
+
+#define MOVE_COLOR_LINEAR 0
+#define MOVE_COLOR_OKLAB 1
+
+/* builds the sRGB encode table, call once before encoding colors */
+void move_color_init(void);
+
+/* converts a color with linear rgb in [0..2] and alpha in [3] to the space
+ * colors are interpolated in */
+void move_color_from_linear(const float linear[4], int space, float out[4]);
+/* unpacks an sRGB rgba color into the interpolation space */
+void move_color_decode(uint32_t rgba, int space, float out[4]);
+/* packs a color in the interpolation space back to sRGB rgba */
+uint32_t move_color_encode(const float color[4], int space);
+
+struct move_color_track {
+	float from[4];
+	float to[4];
+};
+
+/* interpolates count color tracks in one pass */
+void move_color_lerp_batch(const struct move_color_track *tracks,
+			   size_t count, float t, int space, uint32_t *out);
+
+/* interpolates two packed rgba colors the same way the move value filter
+ * does: in linear light or oklab for rgb, straight for alpha */
+uint32_t move_color_lerp(uint32_t from, uint32_t to, float t, int space);
+
+/* rms and absolute sample peak of a block of float samples */
+void move_audio_level(const float *samples, size_t frames, float *rms,
+		      float *peak);
+
+#define MOVE_FFT_BITS 10
+#define MOVE_FFT_SIZE (1 << MOVE_FFT_BITS)
+
+/* tables and work buffers of a hann windowed fft, nothing is allocated when
+ * analysing */
+struct move_fft {
+	float window[MOVE_FFT_SIZE];
+	float scale;
+	float cos[MOVE_FFT_SIZE / 2];
+	float sin[MOVE_FFT_SIZE / 2];
+	uint16_t reverse[MOVE_FFT_SIZE];
+	float re[MOVE_FFT_SIZE];
+	float im[MOVE_FFT_SIZE];
+};
+
+void move_fft_init(struct move_fft *fft);
+/* rms level of the frequencies between low and high, as fractions of the
+ * sample rate, in the last MOVE_FFT_SIZE samples of the ring buffer history
+ * whose oldest sample is at start */
+float move_fft_band_level(struct move_fft *fft, const float *history,
+			  size_t start, float low, float high);
+
+#ifdef __cplusplus
+}
+#endif
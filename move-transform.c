@@ -0,0 +1,223 @@
+#include "move-transform.h"
+#include <stdlib.h>
+#include <string.h>
+
+uint32_t move_transform_mask(const struct move_transform *a,
+			     const struct move_transform *b)
+{
+	uint32_t mask = 0;
+	if (a->pos_x != b->pos_x || a->pos_y != b->pos_y)
+		mask |= CHANGE_POS;
+	if (a->rot != b->rot)
+		mask |= CHANGE_ROT;
+	if (a->scale_x != b->scale_x || a->scale_y != b->scale_y)
+		mask |= CHANGE_SCALE;
+	if (a->bounds_x != b->bounds_x || a->bounds_y != b->bounds_y)
+		mask |= CHANGE_BOUNDS;
+	if (a->crop_left != b->crop_left || a->crop_top != b->crop_top ||
+	    a->crop_right != b->crop_right || a->crop_bottom != b->crop_bottom)
+		mask |= CHANGE_CROP;
+	return mask;
+}
+
+static int move_keyframe_compare(const void *a, const void *b)
+{
+	const struct move_keyframe *ka = a;
+	const struct move_keyframe *kb = b;
+	return ka->time < kb->time ? -1 : (ka->time > kb->time ? 1 : 0);
+}
+
+void move_keyframes_sort(struct move_keyframe *keyframes, size_t count)
+{
+	if (count > 1)
+		qsort(keyframes, count, sizeof(struct move_keyframe),
+		      move_keyframe_compare);
+}
+
+size_t move_path_build(const struct move_path *path,
+		       struct move_keyframe *points,
+		       const struct move_keyframe *keyframes, size_t count,
+		       float duration)
+{
+	if (!count)
+		return 0;
+	size_t num = 0;
+	struct move_keyframe *point = &points[num++];
+	memset(point, 0, sizeof(*point));
+	point->easing = EASE_NONE;
+	point->transform = path->from;
+	for (size_t i = 0; i < count; i++) {
+		if (keyframes[i].time <= 0.0f || keyframes[i].time >= duration)
+			continue;
+		points[num++] = keyframes[i];
+	}
+	point = &points[num++];
+	memset(point, 0, sizeof(*point));
+	point->time = duration;
+	point->easing = path->easing;
+	point->easing_function = path->easing_function;
+	point->transform = path->to;
+	return num;
+}
+
+static void move_path_prepare_points(struct move_path *path)
+{
+	uint32_t mask = 0;
+	for (size_t i = 1; i < path->count; i++) {
+		const struct move_transform *a = &path->points[i - 1].transform;
+		struct move_keyframe *b = &path->points[i];
+		mask |= move_transform_mask(&path->points[0].transform,
+					    &b->transform);
+		if (path->curve == 0.0f ||
+		    path->keyframe_path == KEYFRAME_PATH_SMOOTH)
+			continue;
+		move_curve_control(a->pos_x, a->pos_y, b->transform.pos_x,
+				   b->transform.pos_y, path->curve,
+				   path->canvas_width, path->canvas_height,
+				   &b->control_x, &b->control_y);
+		if (!path->curve_arc_length)
+			continue;
+		float x[3] = {a->pos_x, b->control_x, b->transform.pos_x};
+		float y[3] = {a->pos_y, b->control_y, b->transform.pos_y};
+		move_arc_length_init(&b->arc_length, x, y);
+	}
+	path->change_mask = mask;
+}
+
+void move_path_prepare(struct move_path *path)
+{
+	if (path->count) {
+		move_path_prepare_points(path);
+		return;
+	}
+	path->change_mask = move_transform_mask(&path->from, &path->to);
+	if (path->curve == 0.0f)
+		return;
+	move_curve_control(path->from.pos_x, path->from.pos_y, path->to.pos_x,
+			   path->to.pos_y, path->curve, path->canvas_width,
+			   path->canvas_height, &path->curve_control_x,
+			   &path->curve_control_y);
+	if (!path->curve_arc_length)
+		return;
+	float x[3] = {path->from.pos_x, path->curve_control_x, path->to.pos_x};
+	float y[3] = {path->from.pos_y, path->curve_control_y, path->to.pos_y};
+	move_arc_length_init(&path->arc_length, x, y);
+}
+
+/* everything but the position, crop does not overshoot */
+static void move_transform_lerp(const struct move_transform *a,
+				const struct move_transform *b, uint32_t mask,
+				float t, struct move_transform *out)
+{
+	if (mask & CHANGE_ROT)
+		out->rot = (1.0f - t) * a->rot + t * b->rot;
+	if (mask & CHANGE_SCALE) {
+		out->scale_x = (1.0f - t) * a->scale_x + t * b->scale_x;
+		out->scale_y = (1.0f - t) * a->scale_y + t * b->scale_y;
+	}
+	if (mask & CHANGE_BOUNDS) {
+		out->bounds_x = (1.0f - t) * a->bounds_x + t * b->bounds_x;
+		out->bounds_y = (1.0f - t) * a->bounds_y + t * b->bounds_y;
+	}
+	if (!(mask & CHANGE_CROP))
+		return;
+	if (t > 1.0f)
+		t = 1.0f;
+	else if (t < 0.0f)
+		t = 0.0f;
+	out->crop_left = (int)((1.0f - t) * (float)a->crop_left +
+			       t * (float)b->crop_left);
+	out->crop_top =
+		(int)((1.0f - t) * (float)a->crop_top + t * (float)b->crop_top);
+	out->crop_right = (int)((1.0f - t) * (float)a->crop_right +
+				t * (float)b->crop_right);
+	out->crop_bottom = (int)((1.0f - t) * (float)a->crop_bottom +
+				 t * (float)b->crop_bottom);
+}
+
+static void move_path_keyframe_transform(const struct move_path *path,
+					 uint32_t mask, float progress,
+					 float duration,
+					 struct move_transform *out)
+{
+	const struct move_keyframe *points = path->points;
+	const size_t count = path->count;
+	float time = progress * duration;
+	if (time < 0.0f)
+		time = 0.0f;
+	else if (time > points[count - 1].time)
+		time = points[count - 1].time;
+
+	size_t low = 0;
+	size_t high = count - 1;
+	while (high - low > 1) {
+		const size_t mid = (low + high) / 2;
+		if (points[mid].time <= time)
+			low = mid;
+		else
+			high = mid;
+	}
+	const struct move_transform *a = &points[low].transform;
+	const struct move_transform *b = &points[high].transform;
+	float f = points[high].time > points[low].time
+			  ? (time - points[low].time) /
+				    (points[high].time - points[low].time)
+			  : 1.0f;
+	f = get_eased(f, points[high].easing, points[high].easing_function);
+
+	move_transform_lerp(a, b, mask, f, out);
+	if (!(mask & CHANGE_POS))
+		return;
+	if (path->keyframe_path == KEYFRAME_PATH_SMOOTH) {
+		const struct move_transform *before =
+			low ? &points[low - 1].transform : a;
+		const struct move_transform *after =
+			high + 1 < count ? &points[high + 1].transform : b;
+		out->pos_x = catmull_rom(before->pos_x, a->pos_x, b->pos_x,
+					 after->pos_x, f);
+		out->pos_y = catmull_rom(before->pos_y, a->pos_y, b->pos_y,
+					 after->pos_y, f);
+	} else if (path->curve != 0.0f) {
+		const struct move_keyframe *point = &points[high];
+		float x[3] = {a->pos_x, point->control_x, b->pos_x};
+		float y[3] = {a->pos_y, point->control_y, b->pos_y};
+		const float ct = path->curve_arc_length
+					 ? move_arc_length_t(&point->arc_length,
+							     f)
+					 : f;
+		out->pos_x = bezier(x, ct, 2);
+		out->pos_y = bezier(y, ct, 2);
+	} else {
+		out->pos_x = (1.0f - f) * a->pos_x + f * b->pos_x;
+		out->pos_y = (1.0f - f) * a->pos_y + f * b->pos_y;
+	}
+}
+
+void move_path_transform(const struct move_path *path, uint32_t mask, float t,
+			 float progress, float duration,
+			 struct move_transform *out)
+{
+	if (path->count > 1) {
+		move_path_keyframe_transform(path, mask, progress, duration,
+					     out);
+		return;
+	}
+	const struct move_transform *a = &path->from;
+	const struct move_transform *b = &path->to;
+	move_transform_lerp(a, b, mask, t, out);
+	if (!(mask & CHANGE_POS))
+		return;
+	if (path->curve != 0.0f) {
+		float x[3] = {a->pos_x, path->curve_control_x, b->pos_x};
+		float y[3] = {a->pos_y, path->curve_control_y, b->pos_y};
+		const float ct = path->curve_arc_length
+					 ? move_arc_length_t(&path->arc_length,
+							     t)
+					 : t;
+		out->pos_x = bezier(x, ct, 2);
+		out->pos_y = bezier(y, ct, 2);
+	} else {
+		out->pos_x = (1.0f - t) * a->pos_x + t * b->pos_x;
+		out->pos_y = (1.0f - t) * a->pos_y + t * b->pos_y;
+	}
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+/* Scene item transform interpolation of the move source filter, shared with
+ * the headless move-eval tool. Nothing in here may depend on libobs. */
+
+#include "move-timeline.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define KEYFRAME_PATH_LINEAR 0
+#define KEYFRAME_PATH_SMOOTH 1
+
+#define CHANGE_POS (1 << 0)
+#define CHANGE_ROT (1 << 1)
+#define CHANGE_SCALE (1 << 2)
+#define CHANGE_BOUNDS (1 << 3)
+#define CHANGE_CROP (1 << 4)
+
+struct move_transform {
+	float pos_x;
+	float pos_y;
+	float rot;
+	float scale_x;
+	float scale_y;
+	float bounds_x;
+	float bounds_y;
+	int crop_left;
+	int crop_top;
+	int crop_right;
+	int crop_bottom;
+};
+
+/* A keyframe is reached at time ms into the move, its easing is applied to
+ * the segment leading up to it. The curve control and arc length of that
+ * segment are set up by move_path_prepare. */
+struct move_keyframe {
+	float time;
+	long long easing;
+	long long easing_function;
+	struct move_transform transform;
+	float control_x;
+	float control_y;
+	struct move_arc_length arc_length;
+};
+
+/* A move from one transform to another, straight or curved, or through the
+ * points of a keyframe path. */
+struct move_path {
+	struct move_transform from;
+	struct move_transform to;
+	float curve;
+	bool curve_arc_length;
+	float curve_control_x;
+	float curve_control_y;
+	struct move_arc_length arc_length;
+	long long keyframe_path;
+	/* easing of the last keyframe segment, which ends on to */
+	long long easing;
+	long long easing_function;
+	uint32_t canvas_width;
+	uint32_t canvas_height;
+	/* owned by the caller, filled by move_path_build */
+	struct move_keyframe *points;
+	size_t count;
+	uint32_t change_mask;
+};
+
+/* CHANGE_ flags of the parts that differ between a and b */
+uint32_t move_transform_mask(const struct move_transform *a,
+			     const struct move_transform *b);
+
+void move_keyframes_sort(struct move_keyframe *keyframes, size_t count);
+
+/* Fills points, which needs room for count + 2 keyframes, with from, the
+ * keyframes inside the duration and to. Returns the number of points, 0
+ * when there are no keyframes. */
+size_t move_path_build(const struct move_path *path,
+		       struct move_keyframe *points,
+		       const struct move_keyframe *keyframes, size_t count,
+		       float duration);
+
+/* curve control, arc length table and change mask, call whenever from, to
+ * or the points change */
+void move_path_prepare(struct move_path *path);
+
+/* Writes the parts in mask of the transform at eased progress t. A keyframe
+ * path is walked by the linear progress of the move instead, the easing of
+ * each segment is applied to that segment. */
+void move_path_transform(const struct move_path *path, uint32_t mask, float t,
+			 float progress, float duration,
+			 struct move_transform *out);
+
+#ifdef __cplusplus
+}
+#endif
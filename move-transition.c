@@ -628,17 +628,6 @@ void calc_edge_position(struct vec2 *pos, long long position,
 	}
 }
 
-float bezier(float point[], float t, int order)
-{
-	const float p = 1.0f - t;
-	if (order < 1)
-		return point[0];
-	if (order == 1)
-		return p * point[0] + t * point[1];
-	return p * bezier(point, t, order - 1) +
-	       t * bezier(&point[1], t, order - 1);
-}
-
 void vec2_bezier(struct vec2 *dst, struct vec2 *begin, struct vec2 *control,
 		 struct vec2 *end, const float t)
 {
@@ -668,116 +657,6 @@ static obs_source_t *obs_frontend_get_transition(const char *name)
 	return NULL;
 }
 
-float get_eased(float f, long long easing, long long easing_function)
-{
-	float t = f;
-	if (EASE_NONE == easing) {
-	} else if (EASE_IN == easing) {
-		switch (easing_function) {
-		case EASING_QUADRATIC:
-			t = QuadraticEaseIn(f);
-			break;
-		case EASING_CUBIC:
-			t = CubicEaseIn(f);
-			break;
-		case EASING_QUARTIC:
-			t = QuarticEaseIn(f);
-			break;
-		case EASING_QUINTIC:
-			t = QuinticEaseIn(f);
-			break;
-		case EASING_SINE:
-			t = SineEaseIn(f);
-			break;
-		case EASING_CIRCULAR:
-			t = CircularEaseIn(f);
-			break;
-		case EASING_EXPONENTIAL:
-			t = ExponentialEaseIn(f);
-			break;
-		case EASING_ELASTIC:
-			t = ElasticEaseIn(f);
-			break;
-		case EASING_BOUNCE:
-			t = BounceEaseIn(f);
-			break;
-		case EASING_BACK:
-			t = BackEaseIn(f);
-			break;
-		default:;
-		}
-	} else if (EASE_OUT == easing) {
-		switch (easing_function) {
-		case EASING_QUADRATIC:
-			t = QuadraticEaseOut(f);
-			break;
-		case EASING_CUBIC:
-			t = CubicEaseOut(f);
-			break;
-		case EASING_QUARTIC:
-			t = QuarticEaseOut(f);
-			break;
-		case EASING_QUINTIC:
-			t = QuinticEaseOut(f);
-			break;
-		case EASING_SINE:
-			t = SineEaseOut(f);
-			break;
-		case EASING_CIRCULAR:
-			t = CircularEaseOut(f);
-			break;
-		case EASING_EXPONENTIAL:
-			t = ExponentialEaseOut(f);
-			break;
-		case EASING_ELASTIC:
-			t = ElasticEaseOut(f);
-			break;
-		case EASING_BOUNCE:
-			t = BounceEaseOut(f);
-			break;
-		case EASING_BACK:
-			t = BackEaseOut(f);
-			break;
-		default:;
-		}
-	} else if (EASE_IN_OUT == easing) {
-		switch (easing_function) {
-		case EASING_QUADRATIC:
-			t = QuadraticEaseInOut(f);
-			break;
-		case EASING_CUBIC:
-			t = CubicEaseInOut(f);
-			break;
-		case EASING_QUARTIC:
-			t = QuarticEaseInOut(f);
-			break;
-		case EASING_QUINTIC:
-			t = QuinticEaseInOut(f);
-			break;
-		case EASING_SINE:
-			t = SineEaseInOut(f);
-			break;
-		case EASING_CIRCULAR:
-			t = CircularEaseInOut(f);
-			break;
-		case EASING_EXPONENTIAL:
-			t = ExponentialEaseInOut(f);
-			break;
-		case EASING_ELASTIC:
-			t = ElasticEaseInOut(f);
-			break;
-		case EASING_BOUNCE:
-			t = BounceEaseInOut(f);
-			break;
-		case EASING_BACK:
-			t = BackEaseInOut(f);
-			break;
-		default:;
-		}
-	}
-	return t;
-}
-
 obs_source_t *get_transition(const char *transition_name, void *pool_data,
 			     size_t *index, bool cache)
 {
@@ -2689,10 +2568,12 @@ extern struct obs_source_info move_audio_action_filter;
 #ifdef WIN32
 void SetMoveDirectShowFilter(struct obs_source_info *obs_source_info);
 #endif
+void move_value_props_free(void);
 
 bool obs_module_load(void)
 {
 	blog(LOG_INFO, "[Move Transition] loaded version %s", PROJECT_VERSION);
+	move_color_init();
 	obs_register_source(&move_transition);
 	obs_register_source(&move_transition_override_filter);
 	obs_register_source(&move_source_filter);
@@ -2708,3 +2589,8 @@ bool obs_module_load(void)
 #endif
 	return true;
 }
+
+void obs_module_unload(void)
+{
+	move_value_props_free();
+}
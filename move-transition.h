@@ -3,6 +3,9 @@
 #include <obs-module.h>
 #include <util/darray.h>
 #include "version.h"
+#include "move-timeline.h"
+#include "move-transform.h"
+#include "move-value.h"
 
 #define MOVE_SOURCE_FILTER_ID "move_source_filter"
 #define MOVE_VALUE_FILTER_ID "move_value_filter"
@@ -39,6 +42,7 @@
 #define S_EASING_FUNCTION_IN "easing_function_in"
 #define S_EASING_FUNCTION_OUT "easing_function_out"
 #define S_CURVE_MATCH "curve_match"
+#define S_CURVE_ARC_LENGTH "curve_arc_length"
 #define S_CURVE_IN "curve_in"
 #define S_CURVE_OUT "curve_out"
 #define S_CURVE_OVERRIDE_MATCH "curve_override_match"
@@ -92,18 +96,26 @@
 #define S_SETTING_FLOAT_MIN "setting_float_min"
 #define S_SETTING_FLOAT_MAX "setting_float_max"
 #define S_SETTING_DECIMALS "setting_decimals"
+#define S_UPDATE_RATE "update_rate"
+#define S_COLOR_INTERPOLATION "color_interpolation"
 #define S_SETTING_FORMAT_TYPE "setting_format_type"
 #define S_SETTING_FORMAT "setting_format"
 #define S_SETTING_COLOR "setting_color"
 #define S_SETTING_COLOR_MIN "setting_color_min"
 #define S_SETTING_COLOR_MAX "setting_color_max"
 #define S_SETTING_TEXT "setting_text"
+#define S_TYPING_STEP "typing_step"
 #define S_SETTINGS "settings"
 #define S_SETTING_FROM "setting_from"
 #define S_SETTING_TO "setting_to"
 #define S_VALUE_TYPE "value_type"
 #define S_TRANSFORM "transform"
 #define S_TRANSFORM_RELATIVE "transform_relative"
+#define S_KEYFRAMES "keyframes"
+#define S_KEYFRAME_TIME "keyframe_time"
+#define S_KEYFRAME_PATH "keyframe_path"
+#define S_KEYFRAME_EASING "keyframe_easing"
+#define S_KEYFRAME_EASING_FUNCTION "keyframe_easing_function"
 #define S_VISIBILITY_ORDER "visibility_order"
 #define S_CHANGE_VISIBILITY "change_visibility"
 #define S_CHANGE_ORDER "change_order"
@@ -125,22 +137,6 @@
 #define ZOOM_NO 0
 #define ZOOM_YES 1
 
-#define EASE_NONE 0
-#define EASE_IN 1
-#define EASE_OUT 2
-#define EASE_IN_OUT 3
-
-#define EASING_QUADRATIC 1
-#define EASING_CUBIC 2
-#define EASING_QUARTIC 3
-#define EASING_QUINTIC 4
-#define EASING_SINE 5
-#define EASING_CIRCULAR 6
-#define EASING_EXPONENTIAL 7
-#define EASING_ELASTIC 8
-#define EASING_BOUNCE 9
-#define EASING_BACK 10
-
 #define POS_NONE 0
 #define POS_CENTER (1 << 0)
 #define POS_EDGE (1 << 1)
@@ -165,37 +161,6 @@
 #define START_TRIGGER_MEDIA_ENDED 12
 #define START_TRIGGER_LOAD 13
 
-#define MOVE_VALUE_UNKNOWN 0
-#define MOVE_VALUE_INT 1
-#define MOVE_VALUE_FLOAT 2
-#define MOVE_VALUE_COLOR 3
-#define MOVE_VALUE_TEXT 4
-
-#define MOVE_VALUE_FORMAT_DECIMALS 0
-#define MOVE_VALUE_FORMAT_FLOAT 1
-#define MOVE_VALUE_FORMAT_TIME 2
-
-#define NEXT_MOVE_ON_END 0
-#define NEXT_MOVE_ON_HOTKEY 1
-#define NEXT_MOVE_REVERSE "Reverse"
-
-#define CHANGE_VISIBILITY_NONE 0
-#define CHANGE_VISIBILITY_SHOW_START 1
-#define CHANGE_VISIBILITY_HIDE_END 2
-#define CHANGE_VISIBILITY_TOGGLE 3
-#define CHANGE_VISIBILITY_SHOW_END 4
-#define CHANGE_VISIBILITY_HIDE_START 5
-#define CHANGE_VISIBILITY_TOGGLE_START 6
-#define CHANGE_VISIBILITY_TOGGLE_END 7
-#define CHANGE_VISIBILITY_SHOW_START_END 8
-#define CHANGE_VISIBILITY_HIDE_START_END 9
-
-#define CHANGE_ORDER_NONE 0
-#define CHANGE_ORDER_RELATIVE (1 << 0)
-#define CHANGE_ORDER_ABSOLUTE (1 << 1)
-#define CHANGE_ORDER_START (1 << 2)
-#define CHANGE_ORDER_END (1 << 3)
-
 #define MEDIA_ACTION_NONE 0
 #define MEDIA_ACTION_PLAY 1
 #define MEDIA_ACTION_PAUSE 2
@@ -214,12 +179,6 @@
 #define MUTE_ACTION_MUTE_DURING 5
 #define MUTE_ACTION_UNMUTE_DURING 6
 
-#define MOVE_VALUE_TYPE_SINGLE_SETTING 0
-#define MOVE_VALUE_TYPE_SETTINGS 1
-#define MOVE_VALUE_TYPE_RANDOM 2
-#define MOVE_VALUE_TYPE_SETTING_ADD 3
-#define MOVE_VALUE_TYPE_TYPING 4
-
 struct move_filter {
 	obs_source_t *source;
 	char *filter_name;
@@ -4,6 +4,7 @@
 #include <stdio.h>
 #include <time.h>
 #include <util/dstr.h>
+#include <util/threading.h>
 #include <obs-frontend-api.h>
 
 #define TEXT_BUFFER_SIZE 256
@@ -17,12 +18,39 @@
 #define BALANCE_MAX 100.0
 #define BALANCE_STEP 1.0
 
+/* the last value a filter wrote to a setting during the current move */
+struct move_value_last {
+	bool set;
+	long long int_value;
+	double double_value;
+};
+
+struct move_value_setting {
+	char *name;
+	long long value_type;
+	double from;
+	double to;
+	double step;
+	size_t color;
+	struct move_value_last last;
+};
+
+enum move_value_kind {
+	MOVE_VALUE_KIND_SETTING,
+	MOVE_VALUE_KIND_VOLUME,
+	MOVE_VALUE_KIND_BALANCE,
+};
+
+struct move_value_target;
+
 struct move_value_info {
 	struct move_filter move_filter;
 
 	obs_weak_source_t *filter;
 	char *setting_filter_name;
 	char *setting_name;
+	enum move_value_kind setting_kind;
+	enum obs_data_number_type number_type;
 
 	long long int_to;
 	long long int_value;
@@ -31,6 +59,7 @@ struct move_value_info {
 	long long int_max;
 
 	int decimals;
+	double double_step;
 	double double_to;
 	double double_value;
 	double double_from;
@@ -44,48 +73,540 @@ struct move_value_info {
 	struct vec4 color_max;
 
 	char *text_from;
-	size_t text_from_len;
 	char *text_to;
-	size_t text_to_len;
-	size_t text_same;
+	struct move_typing typing;
 	size_t text_step;
-	size_t text_steps;
+	long long typing_step;
+	char *text_buffer;
+	size_t text_buffer_size;
+	char text_last[TEXT_BUFFER_SIZE];
+	bool text_last_set;
 
 	obs_data_array_t *settings;
+	DARRAY(struct move_value_setting) setting_tracks;
+	DARRAY(struct move_color_track) color_tracks;
+	DARRAY(uint32_t) color_values;
+	struct move_color_track color_track;
+	int color_space;
 
 	long long move_value_type;
 	long long value_type;
 	long long format_type;
 	char *format;
+
+	struct move_value_last value_last;
+
+	long long update_rate;
+	struct move_value_target *target;
+	uint64_t target_frame_time;
+
+	/* resolved target and its settings, held while moving */
+	obs_source_t *move_target;
+	obs_source_t *move_target_parent;
+	obs_data_t *move_target_settings;
+	volatile bool move_target_removed;
+	volatile bool move_target_hold;
 };
 
-static void load_properties(obs_properties_t *props_from,
+/* Move value filters changing the same source share a target, which gets a
+ * single obs_source_update once every moving filter on it has ticked for the
+ * frame, at most at the update rate of the target. The targets mutex guards
+ * the list and who is a member of which target, the mutex of a target its
+ * members and frame state. */
+struct move_value_target {
+	pthread_mutex_t mutex;
+	obs_source_t *source;
+	obs_weak_source_t *weak;
+	uint64_t frame_time;
+	uint64_t update_time;
+	bool update;
+	DARRAY(struct move_value_info *) members;
+};
+
+static DARRAY(struct move_value_target *) move_value_targets;
+static pthread_mutex_t move_value_targets_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+struct move_value_name_slot {
+	const char *name;
+	size_t index;
+};
+
+/* open addressing table from a setting name to an array index */
+struct move_value_name_index {
+	struct move_value_name_slot *slots;
+	size_t mask;
+};
+
+struct move_value_prop {
+	char *name;
+	enum obs_property_type type;
+	bool visible;
+	double step;
+};
+
+/* flattened properties of a source, shared between users by reference */
+struct move_value_props {
+	long refs;
+	DARRAY(struct move_value_prop) props;
+	struct move_value_name_index index;
+};
+
+/* props stay valid until the source is updated by anything but a move value
+ * target, generation counts the updates so a build that raced one is not
+ * marked valid */
+struct move_value_props_cache {
+	obs_weak_source_t *source;
+	bool valid;
+	bool self_update;
+	long generation;
+	struct move_value_props *props;
+};
+
+static DARRAY(struct move_value_props_cache *) move_value_props_caches;
+static pthread_mutex_t move_value_props_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+static void move_value_classify(struct move_value_info *move_value)
+{
+	if (strcmp(move_value->setting_name, VOLUME_SETTING) == 0)
+		move_value->setting_kind = MOVE_VALUE_KIND_VOLUME;
+	else if (strcmp(move_value->setting_name, BALANCE_SETTING) == 0)
+		move_value->setting_kind = MOVE_VALUE_KIND_BALANCE;
+	else
+		move_value->setting_kind = MOVE_VALUE_KIND_SETTING;
+}
+
+static void move_value_set_text_to(struct move_value_info *move_value,
+				   const char *text_to)
+{
+	if (move_value->text_to && strcmp(move_value->text_to, text_to) == 0)
+		return;
+	bfree(move_value->text_to);
+	move_value->text_to = bstrdup(text_to);
+}
+
+static void move_value_typing_start(struct move_value_info *move_value,
+				    const char *text_from)
+{
+	const size_t len = strlen(text_from);
+	move_value->text_from = brealloc(move_value->text_from, len + 1);
+	memcpy(move_value->text_from, text_from, len + 1);
+	move_typing_init(&move_value->typing, move_value->text_from,
+			 move_value->text_to ? move_value->text_to : "");
+	move_value->text_step = 0;
+
+	size_t size = move_value->typing.from_len > move_value->typing.to_len
+			      ? move_value->typing.from_len
+			      : move_value->typing.to_len;
+	size++;
+	if (size > move_value->text_buffer_size) {
+		move_value->text_buffer =
+			brealloc(move_value->text_buffer, size);
+		move_value->text_buffer_size = size;
+	}
+}
+
+/* The target runs at the fastest update rate of its filters, it updates every
+ * frame when one of them has no rate or is at the end of its move. */
+static bool move_value_target_due(struct move_value_target *target)
+{
+	long long rate = 0;
+	for (size_t i = 0; i < target->members.num; i++) {
+		const struct move_value_info *member = target->members.array[i];
+		if (!member->move_filter.moving || member->update_rate <= 0)
+			return true;
+		if (member->update_rate > rate)
+			rate = member->update_rate;
+	}
+	return (target->frame_time - target->update_time) * (uint64_t)rate >=
+	       1000000000ULL;
+}
+
+static obs_weak_source_t *
+move_value_target_take(struct move_value_target *target, bool force)
+{
+	if (!target->update || (!force && !move_value_target_due(target)))
+		return NULL;
+	target->update = false;
+	target->update_time = target->frame_time;
+	obs_weak_source_addref(target->weak);
+	return target->weak;
+}
+
+static bool move_value_target_complete(struct move_value_target *target)
+{
+	for (size_t i = 0; i < target->members.num; i++) {
+		if (target->members.array[i]->target_frame_time !=
+		    target->frame_time)
+			return false;
+	}
+	return true;
+}
+
+static void move_value_props_self_update(obs_source_t *source);
+
+static void move_value_target_update(obs_weak_source_t *weak)
+{
+	if (!weak)
+		return;
+	obs_source_t *source = obs_weak_source_get_source(weak);
+	obs_weak_source_release(weak);
+	if (!source)
+		return;
+	move_value_props_self_update(source);
+	obs_source_update(source, NULL);
+	obs_source_release(source);
+}
+
+/* call with the targets mutex held */
+static obs_weak_source_t *
+move_value_target_remove(struct move_value_info *move_value, bool apply)
+{
+	struct move_value_target *target = move_value->target;
+	obs_weak_source_t *weak = NULL;
+	pthread_mutex_lock(&target->mutex);
+	move_value->target = NULL;
+	da_erase_item(target->members, &move_value);
+	if (apply && move_value_target_complete(target))
+		weak = move_value_target_take(target, true);
+	const bool empty = !target->members.num;
+	pthread_mutex_unlock(&target->mutex);
+	if (empty) {
+		da_erase_item(move_value_targets, &target);
+		if (!move_value_targets.num)
+			da_free(move_value_targets);
+		obs_weak_source_release(target->weak);
+		da_free(target->members);
+		pthread_mutex_destroy(&target->mutex);
+		bfree(target);
+	}
+	return weak;
+}
+
+static void move_value_target_leave(struct move_value_info *move_value,
+				    bool apply)
+{
+	if (!move_value->target)
+		return;
+	pthread_mutex_lock(&move_value_targets_mutex);
+	obs_weak_source_t *weak = move_value_target_remove(move_value, apply);
+	pthread_mutex_unlock(&move_value_targets_mutex);
+	move_value_target_update(weak);
+}
+
+/* call with the targets mutex held */
+static void move_value_target_join(struct move_value_info *move_value,
+				   obs_source_t *source, uint64_t frame_time)
+{
+	struct move_value_target *target = NULL;
+	for (size_t i = 0; i < move_value_targets.num; i++) {
+		if (move_value_targets.array[i]->source == source) {
+			target = move_value_targets.array[i];
+			break;
+		}
+	}
+	if (!target) {
+		target = bzalloc(sizeof(struct move_value_target));
+		pthread_mutex_init(&target->mutex, NULL);
+		target->source = source;
+		target->weak = obs_source_get_weak_source(source);
+		target->frame_time = frame_time;
+		da_push_back(move_value_targets, &target);
+	}
+	pthread_mutex_lock(&target->mutex);
+	da_push_back(target->members, &move_value);
+	pthread_mutex_unlock(&target->mutex);
+	move_value->target = target;
+}
+
+/* Marks the filter as ticked for this frame, requesting an update of source
+ * when update is set. With source NULL the filter keeps its current target.
+ * Only joining or switching a target takes the targets mutex. */
+static void move_value_target_tick(struct move_value_info *move_value,
+				   obs_source_t *source, bool update)
+{
+	if (!move_value->target && (!update || !source))
+		return;
+	const uint64_t frame_time = obs_get_video_frame_time();
+	obs_weak_source_t *previous = NULL;
+	obs_weak_source_t *weak = NULL;
+	if (!move_value->target ||
+	    (source && move_value->target->source != source)) {
+		pthread_mutex_lock(&move_value_targets_mutex);
+		if (move_value->target)
+			previous = move_value_target_remove(move_value, true);
+		move_value_target_join(move_value, source, frame_time);
+		pthread_mutex_unlock(&move_value_targets_mutex);
+	}
+	struct move_value_target *target = move_value->target;
+	pthread_mutex_lock(&target->mutex);
+	if (target->frame_time != frame_time) {
+		if (!previous)
+			previous = move_value_target_take(target, false);
+		target->frame_time = frame_time;
+	}
+	target->update |= update;
+	move_value->target_frame_time = frame_time;
+	if (move_value_target_complete(target))
+		weak = move_value_target_take(target, false);
+	pthread_mutex_unlock(&target->mutex);
+	move_value_target_update(previous);
+	move_value_target_update(weak);
+}
+
+static uint64_t move_value_name_hash(const char *name)
+{
+	uint64_t hash = 14695981039346656037ULL;
+	for (; *name; name++) {
+		hash ^= (uint8_t)*name;
+		hash *= 1099511628211ULL;
+	}
+	return hash;
+}
+
+static void move_value_name_index_init(struct move_value_name_index *index,
+				       size_t count)
+{
+	size_t size = 8;
+	while (size < count * 2)
+		size <<= 1;
+	index->slots = bzalloc(sizeof(struct move_value_name_slot) * size);
+	index->mask = size - 1;
+}
+
+static void move_value_name_index_free(struct move_value_name_index *index)
+{
+	bfree(index->slots);
+	index->slots = NULL;
+	index->mask = 0;
+}
+
+/* a later entry with the same name replaces the earlier one */
+static void move_value_name_index_add(struct move_value_name_index *index,
+				      const char *name, size_t value)
+{
+	size_t i = (size_t)move_value_name_hash(name) & index->mask;
+	while (index->slots[i].name && strcmp(index->slots[i].name, name) != 0)
+		i = (i + 1) & index->mask;
+	index->slots[i].name = name;
+	index->slots[i].index = value;
+}
+
+static bool move_value_name_index_find(struct move_value_name_index *index,
+				       const char *name, size_t *value)
+{
+	if (!index->slots)
+		return false;
+	size_t i = (size_t)move_value_name_hash(name) & index->mask;
+	while (index->slots[i].name) {
+		if (strcmp(index->slots[i].name, name) == 0) {
+			if (value)
+				*value = index->slots[i].index;
+			return true;
+		}
+		i = (i + 1) & index->mask;
+	}
+	return false;
+}
+
+static void move_value_props_add(struct move_value_props *props,
+				 obs_properties_t *sps, bool visible)
+{
+	obs_property_t *prop = obs_properties_first(sps);
+	for (; prop != NULL; obs_property_next(&prop)) {
+		struct move_value_prop *item = da_push_back_new(props->props);
+		item->name = bstrdup(obs_property_name(prop));
+		item->type = obs_property_get_type(prop);
+		item->visible = visible && obs_property_visible(prop);
+		item->step = item->type == OBS_PROPERTY_FLOAT
+				     ? obs_property_float_step(prop)
+				     : 0.0;
+		if (item->type == OBS_PROPERTY_GROUP)
+			move_value_props_add(props,
+					     obs_property_group_content(prop),
+					     item->visible);
+	}
+}
+
+static struct move_value_props *move_value_props_create(obs_source_t *source)
+{
+	struct move_value_props *props =
+		bzalloc(sizeof(struct move_value_props));
+	props->refs = 1;
+	obs_properties_t *sps = obs_source_properties(source);
+	move_value_props_add(props, sps, true);
+	obs_properties_destroy(sps);
+	move_value_name_index_init(&props->index, props->props.num);
+	for (size_t i = 0; i < props->props.num; i++)
+		move_value_name_index_add(&props->index,
+					  props->props.array[i].name, i);
+	return props;
+}
+
+/* caller must hold move_value_props_mutex */
+static void move_value_props_release_locked(struct move_value_props *props)
+{
+	if (!props || --props->refs > 0)
+		return;
+	for (size_t i = 0; i < props->props.num; i++)
+		bfree(props->props.array[i].name);
+	da_free(props->props);
+	move_value_name_index_free(&props->index);
+	bfree(props);
+}
+
+static void move_value_props_release(struct move_value_props *props)
+{
+	pthread_mutex_lock(&move_value_props_mutex);
+	move_value_props_release_locked(props);
+	pthread_mutex_unlock(&move_value_props_mutex);
+}
+
+static void move_value_props_source_update(void *data, calldata_t *call_data)
+{
+	UNUSED_PARAMETER(call_data);
+	struct move_value_props_cache *cache = data;
+	pthread_mutex_lock(&move_value_props_mutex);
+	if (cache->self_update) {
+		cache->self_update = false;
+	} else {
+		cache->valid = false;
+		cache->generation++;
+	}
+	pthread_mutex_unlock(&move_value_props_mutex);
+}
+
+/* marks the next update signal of source as one a move value target issued,
+ * which does not change the properties */
+static void move_value_props_self_update(obs_source_t *source)
+{
+	pthread_mutex_lock(&move_value_props_mutex);
+	for (size_t i = 0; i < move_value_props_caches.num; i++) {
+		struct move_value_props_cache *cache =
+			move_value_props_caches.array[i];
+		if (obs_weak_source_references_source(cache->source, source)) {
+			cache->self_update = true;
+			break;
+		}
+	}
+	pthread_mutex_unlock(&move_value_props_mutex);
+}
+
+static void
+move_value_props_cache_connect(struct move_value_props_cache *cache,
+			       obs_weak_source_t *weak, bool connect)
+{
+	obs_source_t *source = obs_weak_source_get_source(weak);
+	if (!source)
+		return;
+	signal_handler_t *sh = obs_source_get_signal_handler(source);
+	if (connect)
+		signal_handler_connect(sh, "update",
+				       move_value_props_source_update, cache);
+	else
+		signal_handler_disconnect(sh, "update",
+					  move_value_props_source_update,
+					  cache);
+	obs_source_release(source);
+}
+
+static void move_value_props_cache_free(struct move_value_props_cache *cache)
+{
+	move_value_props_cache_connect(cache, cache->source, false);
+	obs_weak_source_release(cache->source);
+	move_value_props_release(cache->props);
+	bfree(cache);
+}
+
+/* properties of the source from its cache entry, which is built again once
+ * the source was updated since. Entries of sources that are gone are dropped
+ * on the way. */
+static struct move_value_props *move_value_props_get(obs_source_t *source)
+{
+	struct move_value_props *props = NULL;
+	DARRAY(struct move_value_props_cache *) expired;
+	da_init(expired);
+
+	pthread_mutex_lock(&move_value_props_mutex);
+	struct move_value_props_cache *cache = NULL;
+	for (size_t i = move_value_props_caches.num; i > 0; i--) {
+		struct move_value_props_cache *c =
+			move_value_props_caches.array[i - 1];
+		if (obs_weak_source_references_source(c->source, source)) {
+			cache = c;
+		} else if (obs_weak_source_expired(c->source)) {
+			da_push_back(expired, &c);
+			da_erase(move_value_props_caches, i - 1);
+		}
+	}
+	const bool created = !cache;
+	if (created) {
+		cache = bzalloc(sizeof(struct move_value_props_cache));
+		cache->source = obs_source_get_weak_source(source);
+		da_push_back(move_value_props_caches, &cache);
+	} else if (cache->valid && cache->props) {
+		props = cache->props;
+		props->refs++;
+	}
+	const long generation = cache->generation;
+	pthread_mutex_unlock(&move_value_props_mutex);
+
+	for (size_t i = 0; i < expired.num; i++)
+		move_value_props_cache_free(expired.array[i]);
+	da_free(expired);
+
+	if (props)
+		return props;
+	if (created)
+		move_value_props_cache_connect(cache, cache->source, true);
+
+	props = move_value_props_create(source);
+
+	pthread_mutex_lock(&move_value_props_mutex);
+	move_value_props_release_locked(cache->props);
+	cache->props = props;
+	cache->valid = cache->generation == generation;
+	props->refs++;
+	pthread_mutex_unlock(&move_value_props_mutex);
+	return props;
+}
+
+void move_value_props_free(void)
+{
+	for (size_t i = 0; i < move_value_props_caches.num; i++)
+		move_value_props_cache_free(move_value_props_caches.array[i]);
+	da_free(move_value_props_caches);
+}
+
+static void load_properties(struct move_value_props *props,
 			    obs_data_array_t *array, obs_data_t *settings_to,
 			    obs_data_t *settings_from)
 {
-	obs_property_t *prop_from = obs_properties_first(props_from);
-	for (; prop_from != NULL; obs_property_next(&prop_from)) {
-		const char *name = obs_property_name(prop_from);
-		if (!obs_property_visible(prop_from))
+	const size_t count = obs_data_array_count(array);
+	struct move_value_name_index index;
+	move_value_name_index_init(&index, count);
+	obs_data_t **items = bzalloc(sizeof(obs_data_t *) * (count + 1));
+	for (size_t i = 0; i < count; i++) {
+		items[i] = obs_data_array_item(array, i);
+		move_value_name_index_add(
+			&index, obs_data_get_string(items[i], S_SETTING_NAME),
+			i);
+	}
+
+	for (size_t p = 0; p < props->props.num; p++) {
+		const struct move_value_prop *prop = props->props.array + p;
+		const char *name = prop->name;
+		if (!prop->visible)
 			continue;
 
 		obs_data_t *setting = NULL;
-		const size_t count = obs_data_array_count(array);
-		for (size_t i = 0; i < count; i++) {
-			obs_data_t *item2 = obs_data_array_item(array, i);
-			const char *setting_name2 =
-				obs_data_get_string(item2, S_SETTING_NAME);
-			if (strcmp(setting_name2, name) == 0) {
-				setting = item2;
-			}
+		size_t i;
+		if (move_value_name_index_find(&index, name, &i)) {
+			setting = items[i];
+			obs_data_addref(setting);
 		}
 
-		const enum obs_property_type prop_type =
-			obs_property_get_type(prop_from);
-		if (prop_type == OBS_PROPERTY_GROUP) {
-			load_properties(obs_property_group_content(prop_from),
-					array, settings_to, settings_from);
-		} else if (prop_type == OBS_PROPERTY_INT) {
+		const enum obs_property_type prop_type = prop->type;
+		if (prop_type == OBS_PROPERTY_INT) {
 			if (!setting) {
 				setting = obs_data_create();
 				obs_data_set_string(setting, S_SETTING_NAME,
@@ -145,31 +666,40 @@ static void load_properties(obs_properties_t *props_from,
 				obs_data_get_int(settings_from, name);
 			obs_data_set_int(setting, S_SETTING_FROM, from);
 		}
+		obs_data_release(setting);
 	}
+
+	for (size_t i = 0; i < count; i++)
+		obs_data_release(items[i]);
+	bfree(items);
+	move_value_name_index_free(&index);
 }
 
 void move_values_load_properties(struct move_value_info *move_value,
 				 obs_source_t *source, obs_data_t *settings)
 {
 	if (source && source != move_value->move_filter.source) {
-		obs_properties_t *sps = obs_source_properties(source);
+		struct move_value_props *props = move_value_props_get(source);
 		size_t index = 0;
 		while (index < obs_data_array_count(move_value->settings)) {
 			obs_data_t *item = obs_data_array_item(
 				move_value->settings, index);
 			const char *setting_name =
 				obs_data_get_string(item, S_SETTING_NAME);
-			if (obs_properties_get(sps, setting_name) == NULL) {
+			if (!move_value_name_index_find(&props->index,
+							setting_name, NULL)) {
 				obs_data_array_erase(move_value->settings,
 						     index);
 			} else {
 				index++;
 			}
+			obs_data_release(item);
 		}
 		obs_data_t *data_from = obs_source_get_settings(source);
-		load_properties(sps, move_value->settings, settings, data_from);
+		load_properties(props, move_value->settings, settings,
+				data_from);
 		obs_data_release(data_from);
-		obs_properties_destroy(sps);
+		move_value_props_release(props);
 	} else {
 		while (obs_data_array_count(move_value->settings)) {
 			obs_data_array_erase(move_value->settings, 0);
@@ -177,63 +707,186 @@ void move_values_load_properties(struct move_value_info *move_value,
 	}
 }
 
-long long rand_between(long long a, long long b)
+/* step of the float property with this name, 0 when unknown */
+static double move_value_prop_step(struct move_value_props *props,
+				   const char *name)
 {
-	return b > a ? a + rand() % (b - a) : b + rand() % (a - b);
+	size_t i;
+	if (!props || !name ||
+	    !move_value_name_index_find(&props->index, name, &i))
+		return 0.0;
+	return props->props.array[i].step;
 }
 
-float rand_between_float(float a, float b)
+static void move_value_free_tracks(struct move_value_info *move_value)
 {
-	return b > a ? a + (b - a) * (float)rand() / (float)RAND_MAX
-		     : b + (a - b) * (float)rand() / (float)RAND_MAX;
+	for (size_t i = 0; i < move_value->setting_tracks.num; i++)
+		bfree(move_value->setting_tracks.array[i].name);
+	da_resize(move_value->setting_tracks, 0);
+	da_resize(move_value->color_tracks, 0);
 }
-double rand_between_double(double a, double b)
+
+/* copies the settings array into native tracks so the tick does not need to
+ * look anything up by name */
+static void move_value_compile_settings(struct move_value_info *move_value,
+					obs_source_t *source)
 {
-	return b > a ? a + (b - a) * (double)rand() / (double)RAND_MAX
-		     : b + (a - b) * (double)rand() / (double)RAND_MAX;
+	move_value_free_tracks(move_value);
+	struct move_value_props *props =
+		source && source != move_value->move_filter.source
+			? move_value_props_get(source)
+			: NULL;
+	const size_t count = obs_data_array_count(move_value->settings);
+	for (size_t i = 0; i < count; i++) {
+		obs_data_t *item = obs_data_array_item(move_value->settings, i);
+		const long long value_type =
+			obs_data_get_int(item, S_VALUE_TYPE);
+		if (value_type != MOVE_VALUE_INT &&
+		    value_type != MOVE_VALUE_FLOAT &&
+		    value_type != MOVE_VALUE_COLOR) {
+			obs_data_release(item);
+			continue;
+		}
+		struct move_value_setting *setting =
+			da_push_back_new(move_value->setting_tracks);
+		setting->name =
+			bstrdup(obs_data_get_string(item, S_SETTING_NAME));
+		setting->value_type = value_type;
+		if (value_type == MOVE_VALUE_INT) {
+			setting->from =
+				(double)obs_data_get_int(item, S_SETTING_FROM);
+			setting->to =
+				(double)obs_data_get_int(item, S_SETTING_TO);
+		} else if (value_type == MOVE_VALUE_FLOAT) {
+			setting->from =
+				obs_data_get_double(item, S_SETTING_FROM);
+			setting->to = obs_data_get_double(item, S_SETTING_TO);
+			setting->step =
+				move_value_prop_step(props, setting->name);
+		} else {
+			setting->color = move_value->color_tracks.num;
+			struct move_color_track *track =
+				da_push_back_new(move_value->color_tracks);
+			const long long from =
+				obs_data_get_int(item, S_SETTING_FROM);
+			const long long to =
+				obs_data_get_int(item, S_SETTING_TO);
+			move_color_decode((uint32_t)from,
+					  move_value->color_space, track->from);
+			move_color_decode((uint32_t)to,
+					  move_value->color_space, track->to);
+		}
+		obs_data_release(item);
+	}
+	da_resize(move_value->color_values, move_value->color_tracks.num);
+	move_value_props_release(props);
 }
 
-double parse_text(long long format_type, const char *format, const char *text)
+static void move_color_track_convert(struct move_color_track *track,
+				     int from_space, int to_space)
 {
-	double value = 0.0;
-	if (format_type == MOVE_VALUE_FORMAT_FLOAT) {
-
-		sscanf(text, format, &value);
-	} else if (format_type == MOVE_VALUE_FORMAT_TIME) {
-		char *pos;
-		unsigned int sec = 0;
-		unsigned int min = 0;
-		unsigned int hour = 0;
-		if (((pos = strstr(format, "%X"))) ||
-		    ((pos = strstr(format, "%H:%M:%S")))) {
-			if ((size_t)(pos - format) < strlen(text))
-				sscanf(text + (pos - format), "%u:%u:%u", &hour,
-				       &min, &sec);
-		} else if (((pos = strstr(format, "%R"))) ||
-			   ((pos = strstr(format, "%H:%M")))) {
-			if ((size_t)(pos - format) < strlen(text))
-				sscanf(text + (pos - format), "%u:%u", &hour,
-				       &min);
-		} else if ((pos = strstr(format, "%M:%S"))) {
-			if ((size_t)(pos - format) < strlen(text))
-				sscanf(text + (pos - format), "%u:%u", &min,
-				       &sec);
-		} else {
-			if ((pos = strstr(format, "%S"))) {
-				sscanf(text + (pos - format), "%u", &sec);
-			}
-			if ((pos = strstr(format, "%M"))) {
-				sscanf(text + (pos - format), "%u", &min);
-			}
-			if ((pos = strstr(format, "%H"))) {
-				sscanf(text + (pos - format), "%u", &hour);
-			}
+	move_color_decode(move_color_encode(track->from, from_space),
+			  to_space, track->from);
+	move_color_decode(move_color_encode(track->to, from_space), to_space,
+			  track->to);
+}
+
+/* tracks are kept in the interpolation space, so a reverse move started after
+ * a space change converts them instead of lerping them in the wrong space */
+static void move_value_set_color_space(struct move_value_info *move_value,
+				       int color_space)
+{
+	if (move_value->color_space == color_space)
+		return;
+	move_color_track_convert(&move_value->color_track,
+				 move_value->color_space, color_space);
+	for (size_t i = 0; i < move_value->color_tracks.num; i++)
+		move_color_track_convert(&move_value->color_tracks.array[i],
+					 move_value->color_space, color_space);
+	move_value->color_space = color_space;
+}
+
+static void move_value_move_target_remove(void *data, calldata_t *call_data)
+{
+	UNUSED_PARAMETER(call_data);
+	struct move_value_info *move_value = data;
+	os_atomic_set_bool(&move_value->move_target_removed, true);
+}
+
+static void move_value_move_target_filter_remove(void *data,
+						 calldata_t *call_data)
+{
+	struct move_value_info *move_value = data;
+	if (calldata_ptr(call_data, "filter") == move_value->move_target)
+		os_atomic_set_bool(&move_value->move_target_removed, true);
+}
+
+/* hold and drop only run on the graphics thread, in the tick, or once the
+ * filter is destroyed */
+static void move_value_drop_move_target(struct move_value_info *move_value)
+{
+	if (!move_value->move_target)
+		return;
+	signal_handler_disconnect(
+		obs_source_get_signal_handler(move_value->move_target),
+		"remove", move_value_move_target_remove, move_value);
+	if (move_value->move_target_parent) {
+		signal_handler_t *sh = obs_source_get_signal_handler(
+			move_value->move_target_parent);
+		signal_handler_disconnect(sh, "filter_remove",
+					  move_value_move_target_filter_remove,
+					  move_value);
+		signal_handler_disconnect(sh, "remove",
+					  move_value_move_target_remove,
+					  move_value);
+		signal_handler_disconnect(sh, "destroy",
+					  move_value_move_target_remove,
+					  move_value);
+		obs_source_release(move_value->move_target_parent);
+		move_value->move_target_parent = NULL;
+	}
+	obs_data_release(move_value->move_target_settings);
+	move_value->move_target_settings = NULL;
+	obs_source_release(move_value->move_target);
+	move_value->move_target = NULL;
+}
+
+/* keeps a strong reference to the target for the duration of the move so the
+ * tick does not need to resolve it every frame */
+static void move_value_hold_move_target(struct move_value_info *move_value,
+					obs_source_t *source)
+{
+	if (source && source == move_value->move_target &&
+	    !os_atomic_load_bool(&move_value->move_target_removed))
+		return;
+	move_value_drop_move_target(move_value);
+	source = obs_source_get_ref(source);
+	if (!source)
+		return;
+	os_atomic_set_bool(&move_value->move_target_removed, false);
+	move_value->move_target = source;
+	move_value->move_target_settings = obs_source_get_settings(source);
+	signal_handler_connect(obs_source_get_signal_handler(source), "remove",
+			       move_value_move_target_remove, move_value);
+	if (obs_source_get_type(source) == OBS_SOURCE_TYPE_FILTER) {
+		obs_source_t *parent =
+			obs_source_get_ref(obs_filter_get_parent(source));
+		if (parent) {
+			move_value->move_target_parent = parent;
+			signal_handler_t *sh =
+				obs_source_get_signal_handler(parent);
+			signal_handler_connect(
+				sh, "filter_remove",
+				move_value_move_target_filter_remove,
+				move_value);
+			signal_handler_connect(sh, "remove",
+					       move_value_move_target_remove,
+					       move_value);
+			signal_handler_connect(sh, "destroy",
+					       move_value_move_target_remove,
+					       move_value);
 		}
-		value = hour * 3600 + min * 60 + sec;
-	} else {
-		value = strtod(text, NULL);
 	}
-	return value;
 }
 
 void move_value_start(struct move_value_info *move_value)
@@ -254,11 +907,15 @@ void move_value_start(struct move_value_info *move_value)
 	if (!move_filter_start_internal(&move_value->move_filter))
 		return;
 
+	/* anything may have changed the target since the last move */
+	move_value->value_last.set = false;
+	move_value->text_last_set = false;
+	for (size_t i = 0; i < move_value->setting_tracks.num; i++)
+		move_value->setting_tracks.array[i].last.set = false;
+
 	if (!move_value->setting_filter_name) {
 		obs_source_update(move_value->move_filter.source, NULL);
 	}
-	if (move_value->move_filter.reverse)
-		return;
 	obs_source_t *source = NULL;
 	if (move_value->setting_filter_name &&
 	    strlen(move_value->setting_filter_name)) {
@@ -267,6 +924,22 @@ void move_value_start(struct move_value_info *move_value)
 	} else {
 		source = obs_filter_get_parent(move_value->move_filter.source);
 	}
+	/* the tick holds the target, so hold and drop stay on one thread */
+	os_atomic_set_bool(&move_value->move_target_hold, true);
+	if (!move_value->settings && source &&
+	    source != move_value->move_filter.source) {
+		struct move_value_props *props = move_value_props_get(source);
+		move_value->double_step = move_value_prop_step(
+			props, move_value->setting_name);
+		move_value_props_release(props);
+	}
+	obs_data_t *fs =
+		obs_source_get_settings(move_value->move_filter.source);
+	move_value_set_color_space(
+		move_value, (int)obs_data_get_int(fs, S_COLOR_INTERPOLATION));
+	obs_data_release(fs);
+	if (move_value->move_filter.reverse)
+		return;
 
 	obs_data_t *ss = obs_source_get_settings(source);
 	if (move_value->settings) {
@@ -274,13 +947,14 @@ void move_value_start(struct move_value_info *move_value)
 			obs_source_get_settings(move_value->move_filter.source);
 		move_values_load_properties(move_value, source, settings);
 		obs_data_release(settings);
+		move_value_compile_settings(move_value, source);
 	} else if (move_value->value_type == MOVE_VALUE_INT) {
-		if (strcmp(move_value->setting_name, VOLUME_SETTING) == 0) {
+		if (move_value->setting_kind == MOVE_VALUE_KIND_VOLUME) {
 			move_value->int_from =
 				(long long)(obs_source_get_volume(source) *
 					    100.0f);
-		} else if (strcmp(move_value->setting_name, BALANCE_SETTING) ==
-			   0) {
+		} else if (move_value->setting_kind ==
+			   MOVE_VALUE_KIND_BALANCE) {
 			move_value->int_from =
 				(long long)(obs_source_get_balance_value(
 						    source) *
@@ -301,11 +975,11 @@ void move_value_start(struct move_value_info *move_value)
 			move_value->int_to = move_value->int_value;
 		}
 	} else if (move_value->value_type == MOVE_VALUE_FLOAT) {
-		if (strcmp(move_value->setting_name, VOLUME_SETTING) == 0) {
+		if (move_value->setting_kind == MOVE_VALUE_KIND_VOLUME) {
 			move_value->double_from =
 				(double)obs_source_get_volume(source) * 100.0;
-		} else if (strcmp(move_value->setting_name, BALANCE_SETTING) ==
-			   0) {
+		} else if (move_value->setting_kind ==
+			   MOVE_VALUE_KIND_BALANCE) {
 			move_value->double_from =
 				(double)obs_source_get_balance_value(source) *
 				100.0;
@@ -356,11 +1030,17 @@ void move_value_start(struct move_value_info *move_value)
 				  &move_value->color_value);
 		}
 		gs_float3_srgb_nonlinear_to_linear(move_value->color_to.ptr);
+		move_color_from_linear(move_value->color_from.ptr,
+				       move_value->color_space,
+				       move_value->color_track.from);
+		move_color_from_linear(move_value->color_to.ptr,
+				       move_value->color_space,
+				       move_value->color_track.to);
 
 	} else if (move_value->value_type == MOVE_VALUE_TEXT) {
 		const char *text_from =
 			obs_data_get_string(ss, move_value->setting_name);
-		move_value->double_from = parse_text(
+		move_value->double_from = move_value_parse(
 			move_value->format_type, move_value->format, text_from);
 
 		if (move_value->move_value_type == MOVE_VALUE_TYPE_RANDOM) {
@@ -372,35 +1052,25 @@ void move_value_start(struct move_value_info *move_value)
 						move_value->double_value;
 		} else if (move_value->move_value_type ==
 			   MOVE_VALUE_TYPE_TYPING) {
-			bfree(move_value->text_from);
-			move_value->text_from = bstrdup(text_from);
-			move_value->text_from_len = strlen(text_from);
-			move_value->text_step = 0;
-			move_value->text_same = 0;
-			while (move_value->text_same <
-				       move_value->text_from_len &&
-			       move_value->text_same <
-				       move_value->text_to_len &&
-			       move_value->text_from[move_value->text_same] ==
-				       move_value
-					       ->text_to[move_value->text_same])
-				move_value->text_same++;
-			move_value->text_steps = (move_value->text_from_len -
-						  move_value->text_same) +
-						 (move_value->text_to_len -
-						  move_value->text_same);
+			obs_data_t *settings = obs_source_get_settings(
+				move_value->move_filter.source);
+			move_value_set_text_to(
+				move_value,
+				obs_data_get_string(settings, S_SETTING_TEXT));
+			obs_data_release(settings);
+			move_value_typing_start(move_value, text_from);
 		} else {
 			move_value->double_to = move_value->double_value;
 		}
 	} else {
-		if (strcmp(move_value->setting_name, VOLUME_SETTING) == 0) {
+		if (move_value->setting_kind == MOVE_VALUE_KIND_VOLUME) {
 			move_value->int_from =
 				(long long)(obs_source_get_volume(source) *
 					    100.0f);
 			move_value->double_from =
 				(double)obs_source_get_volume(source) * 100.0;
-		} else if (strcmp(move_value->setting_name, BALANCE_SETTING) ==
-			   0) {
+		} else if (move_value->setting_kind ==
+			   MOVE_VALUE_KIND_BALANCE) {
 			move_value->int_from =
 				(long long)(obs_source_get_balance_value(
 						    source) *
@@ -414,6 +1084,10 @@ void move_value_start(struct move_value_info *move_value)
 			move_value->double_from = obs_data_get_double(
 				ss, move_value->setting_name);
 		}
+		obs_data_item_t *item =
+			obs_data_item_byname(ss, move_value->setting_name);
+		move_value->number_type = obs_data_item_numtype(item);
+		obs_data_item_release(&item);
 
 		move_value->int_to = move_value->int_value;
 		move_value->double_to = move_value->double_value;
@@ -486,6 +1160,7 @@ void move_value_update(void *data, obs_data_t *settings)
 		bfree(move_value->setting_name);
 
 		move_value->setting_name = bstrdup(setting_name);
+		move_value_classify(move_value);
 	}
 
 	if (obs_data_has_user_value(settings, S_SINGLE_SETTING)) {
@@ -496,6 +1171,11 @@ void move_value_update(void *data, obs_data_t *settings)
 		obs_data_unset_user_value(settings, S_SINGLE_SETTING);
 	}
 
+	if (!move_value->move_filter.moving)
+		move_value_set_color_space(
+			move_value,
+			(int)obs_data_get_int(settings, S_COLOR_INTERPOLATION));
+
 	if (obs_data_get_int(settings, S_MOVE_VALUE_TYPE) !=
 	    MOVE_VALUE_TYPE_SETTINGS) {
 		obs_data_array_release(move_value->settings);
@@ -512,6 +1192,8 @@ void move_value_update(void *data, obs_data_t *settings)
 			source = parent;
 		}
 		move_values_load_properties(move_value, source, settings);
+		if (!move_value->move_filter.moving)
+			move_value_compile_settings(move_value, source);
 	}
 
 	move_value->move_value_type =
@@ -537,6 +1219,7 @@ void move_value_update(void *data, obs_data_t *settings)
 	}
 	move_value->decimals =
 		(int)obs_data_get_int(settings, S_SETTING_DECIMALS);
+	move_value->update_rate = obs_data_get_int(settings, S_UPDATE_RATE);
 	move_value->int_value = obs_data_get_int(settings, S_SETTING_INT);
 	move_value->int_min = obs_data_get_int(settings, S_SETTING_INT_MIN);
 	move_value->int_max = obs_data_get_int(settings, S_SETTING_INT_MAX);
@@ -555,12 +1238,15 @@ void move_value_update(void *data, obs_data_t *settings)
 		       (uint32_t)obs_data_get_int(settings,
 						  S_SETTING_COLOR_MAX));
 
-	const char *text_to = obs_data_get_string(settings, S_SETTING_TEXT);
-	if (!move_value->text_to || strcmp(move_value->text_to, text_to) != 0) {
-		bfree(move_value->text_to);
-		move_value->text_to = bstrdup(text_to);
-		move_value->text_to_len = strlen(text_to);
-	}
+	/* a running typing move keeps its text, the new one is picked up when
+	 * the next move starts */
+	if (!move_value->move_filter.moving)
+		move_value_set_text_to(
+			move_value,
+			obs_data_get_string(settings, S_SETTING_TEXT));
+	move_value->typing_step = obs_data_get_int(settings, S_TYPING_STEP);
+	if (move_value->typing_step < 0)
+		move_value->typing_step = 0;
 
 	if (move_value->move_filter.start_trigger == START_TRIGGER_LOAD) {
 		move_value_start(move_value);
@@ -587,9 +1273,16 @@ static void move_value_destroy(void *data)
 	bfree(move_value->format);
 	bfree(move_value->text_from);
 	bfree(move_value->text_to);
+	bfree(move_value->text_buffer);
 	bfree(move_value->setting_filter_name);
 	bfree(move_value->setting_name);
 	obs_data_array_release(move_value->settings);
+	move_value_target_leave(move_value, false);
+	move_value_drop_move_target(move_value);
+	move_value_free_tracks(move_value);
+	da_free(move_value->setting_tracks);
+	da_free(move_value->color_tracks);
+	da_free(move_value->color_values);
 	bfree(move_value);
 }
 
@@ -687,9 +1380,9 @@ bool move_value_get_value(obs_properties_t *props, obs_property_t *property,
 		if (move_value->move_value_type == MOVE_VALUE_TYPE_TYPING) {
 			obs_data_set_string(settings, S_SETTING_TEXT, text);
 		} else {
-			const double value = parse_text(move_value->format_type,
-							move_value->format,
-							text);
+			const double value =
+				move_value_parse(move_value->format_type,
+						 move_value->format, text);
 			obs_data_set_double(settings, S_SETTING_FLOAT, value);
 			obs_data_set_double(settings, S_SETTING_FLOAT_MIN,
 					    value);
@@ -740,17 +1433,18 @@ bool move_value_get_values(obs_properties_t *props, obs_property_t *property,
 			obs_data_set_int(settings, name, color);
 		} else if (value_type == MOVE_VALUE_TEXT) {
 			const char *text = obs_data_get_string(ss, name);
-			const double value = parse_text(move_value->format_type,
-							move_value->format,
-							text);
+			const double value =
+				move_value_parse(move_value->format_type,
+						 move_value->format, text);
 			obs_data_set_double(settings, name, value);
 		}
+		obs_data_release(item);
 	}
 
 	if (count > 0) {
-		obs_properties_t *sps = obs_source_properties(source);
-		load_properties(sps, move_value->settings, settings, ss);
-		obs_properties_destroy(sps);
+		struct move_value_props *props = move_value_props_get(source);
+		load_properties(props, move_value->settings, settings, ss);
+		move_value_props_release(props);
 	}
 	obs_data_release(ss);
 	obs_data_release(settings);
@@ -957,6 +1651,7 @@ bool move_value_setting_changed(void *data, obs_properties_t *props,
 
 		bfree(move_value->setting_name);
 		move_value->setting_name = bstrdup(setting_name);
+		move_value_classify(move_value);
 	}
 
 	obs_source_t *source;
@@ -988,6 +1683,8 @@ bool move_value_setting_changed(void *data, obs_properties_t *props,
 	obs_property_t *prop_color_max =
 		obs_properties_get(props, S_SETTING_COLOR_MAX);
 	obs_property_t *prop_text = obs_properties_get(props, S_SETTING_TEXT);
+	obs_property_t *prop_typing_step =
+		obs_properties_get(props, S_TYPING_STEP);
 	obs_property_set_visible(prop_int, false);
 	obs_property_set_visible(prop_int_min, false);
 	obs_property_set_visible(prop_int_max, false);
@@ -999,6 +1696,7 @@ bool move_value_setting_changed(void *data, obs_properties_t *props,
 	obs_property_set_visible(prop_color_min, false);
 	obs_property_set_visible(prop_color_max, false);
 	obs_property_set_visible(prop_text, false);
+	obs_property_set_visible(prop_typing_step, false);
 	const long long move_value_type =
 		obs_data_get_int(settings, S_MOVE_VALUE_TYPE);
 
@@ -1244,6 +1942,7 @@ bool move_value_setting_changed(void *data, obs_properties_t *props,
 			}
 		} else if (move_value_type == MOVE_VALUE_TYPE_TYPING) {
 			obs_property_set_visible(prop_text, true);
+			obs_property_set_visible(prop_typing_step, true);
 		}
 		obs_data_set_int(settings, S_VALUE_TYPE, MOVE_VALUE_TEXT);
 	} else {
@@ -1403,6 +2102,10 @@ static obs_properties_t *move_value_properties(void *data)
 				    OBS_TEXT_MULTILINE);
 	obs_property_set_visible(p, false);
 
+	p = obs_properties_add_int(setting_value, S_TYPING_STEP,
+				   obs_module_text("TypingStep"), 0, 1000, 1);
+	obs_property_set_visible(p, false);
+
 	obs_properties_add_button(setting_value, "value_get",
 				  obs_module_text("GetValue"),
 				  move_value_get_value);
@@ -1418,6 +2121,20 @@ static obs_properties_t *move_value_properties(void *data)
 	obs_properties_add_group(ppts, S_SETTINGS, obs_module_text("Settings"),
 				 OBS_GROUP_NORMAL, settings);
 
+	p = obs_properties_add_int(ppts, S_UPDATE_RATE,
+				   obs_module_text("UpdateRate"), 0, 1000, 1);
+	obs_property_int_set_suffix(p, "/s");
+
+	p = obs_properties_add_list(ppts, S_COLOR_INTERPOLATION,
+				    obs_module_text("ColorInterpolation"),
+				    OBS_COMBO_TYPE_LIST, OBS_COMBO_FORMAT_INT);
+	obs_property_list_add_int(
+		p, obs_module_text("ColorInterpolation.Linear"),
+		MOVE_COLOR_LINEAR);
+	obs_property_list_add_int(p,
+				  obs_module_text("ColorInterpolation.OKLab"),
+				  MOVE_COLOR_OKLAB);
+
 	move_filter_properties(&move_value->move_filter, ppts);
 
 	return ppts;
@@ -1431,6 +2148,7 @@ void move_value_defaults(obs_data_t *settings)
 	obs_data_set_default_int(settings, S_EASING_FUNCTION_MATCH,
 				 EASING_CUBIC);
 	obs_data_set_default_bool(settings, S_ENABLED_MATCH_MOVING, true);
+	obs_data_set_default_int(settings, S_TYPING_STEP, 0);
 }
 
 void move_value_video_render(void *data, gs_effect_t *effect)
@@ -1455,6 +2173,35 @@ void move_value_stop(struct move_value_info *move_value)
 	move_filter_stop(&move_value->move_filter);
 }
 
+/* The setters below only write when the value differs from the last one the
+ * filter wrote, so the target is only updated when something changed without
+ * reading the setting back. Doubles are compared at the step of their
+ * property while moving. */
+static bool move_value_set_int(obs_data_t *ss, const char *name,
+			       long long value, struct move_value_last *last)
+{
+	if (last->set && last->int_value == value)
+		return false;
+	obs_data_set_int(ss, name, value);
+	last->int_value = value;
+	last->set = true;
+	return true;
+}
+
+static bool move_value_set_double(obs_data_t *ss, const char *name,
+				  double value, double step,
+				  struct move_value_last *last)
+{
+	if (last->set && (step > 0.0 ? round(last->double_value / step) ==
+					       round(value / step)
+				     : last->double_value == value))
+		return false;
+	obs_data_set_double(ss, name, value);
+	last->double_value = value;
+	last->set = true;
+	return true;
+}
+
 void move_value_tick(void *data, float seconds)
 {
 	struct move_value_info *move_value = data;
@@ -1473,231 +2220,197 @@ void move_value_tick(void *data, float seconds)
 					move_value_start_hotkey, data);
 	}
 	float t;
-	if (!move_filter_tick(&move_value->move_filter, seconds, &t))
+	if (!move_filter_tick(&move_value->move_filter, seconds, &t)) {
+		if (!move_value->move_filter.moving) {
+			move_value_target_leave(move_value, true);
+			move_value_drop_move_target(move_value);
+		} else {
+			move_value_target_tick(move_value, NULL, false);
+		}
 		return;
+	}
 
-	obs_source_t *source;
-	if (move_value->filter) {
-		source = obs_weak_source_get_source(move_value->filter);
-		obs_source_release(source);
-	} else {
-		source = obs_filter_get_parent(move_value->move_filter.source);
+	if (move_value->move_target &&
+	    os_atomic_load_bool(&move_value->move_target_removed))
+		move_value_drop_move_target(move_value);
+	obs_source_t *source = move_value->move_target;
+	const bool hold = os_atomic_load_bool(&move_value->move_target_hold);
+	if (!source || hold) {
+		if (move_value->filter) {
+			source = obs_weak_source_get_source(move_value->filter);
+			obs_source_release(source);
+		} else {
+			source = obs_filter_get_parent(
+				move_value->move_filter.source);
+		}
 	}
-	if (!source)
+	if (hold) {
+		os_atomic_set_bool(&move_value->move_target_hold, false);
+		move_value_hold_move_target(move_value, source);
+	}
+	const bool held = move_value->move_target != NULL;
+	if (!source) {
+		/* keep the update other filters left pending on the target
+		 * until the target itself is gone */
+		if (move_value->target &&
+		    obs_weak_source_expired(move_value->target->weak))
+			move_value_target_leave(move_value, false);
+		else
+			move_value_target_tick(move_value, NULL, false);
 		return;
-	obs_data_t *ss = obs_source_get_settings(source);
-	bool update = true;
+	}
+	obs_data_t *ss = held ? move_value->move_target_settings
+			      : obs_source_get_settings(source);
+	/* the last frame writes the exact end values */
+	const bool moving = move_value->move_filter.moving;
+	bool update = false;
 	if (move_value->settings) {
-		const size_t count = obs_data_array_count(move_value->settings);
-		for (size_t i = 0; i < count; i++) {
-			obs_data_t *item =
-				obs_data_array_item(move_value->settings, i);
-			const char *setting_name =
-				obs_data_get_string(item, S_SETTING_NAME);
-			const long long value_type =
-				obs_data_get_int(item, S_VALUE_TYPE);
-			if (value_type == MOVE_VALUE_INT) {
-				const long long int_from =
-					obs_data_get_int(item, S_SETTING_FROM);
-				const long long int_to =
-					obs_data_get_int(item, S_SETTING_TO);
+		move_color_lerp_batch(move_value->color_tracks.array,
+				      move_value->color_tracks.num, t,
+				      move_value->color_space,
+				      move_value->color_values.array);
+		for (size_t i = 0; i < move_value->setting_tracks.num; i++) {
+			struct move_value_setting *setting =
+				move_value->setting_tracks.array + i;
+			if (setting->value_type == MOVE_VALUE_INT) {
 				const long long value_int =
-					(long long)((1.0 - t) *
-							    (double)int_from +
-						    t * (double)int_to);
-				obs_data_set_int(ss, setting_name, value_int);
-			} else if (value_type == MOVE_VALUE_FLOAT) {
-				const double double_from = obs_data_get_double(
-					item, S_SETTING_FROM);
-				const double double_to =
-					obs_data_get_double(item, S_SETTING_TO);
-				const double value_double =
-					((1.0 - t) * double_from +
-					 t * double_to);
-				obs_data_set_double(ss, setting_name,
-						    value_double);
-			} else if (value_type == MOVE_VALUE_COLOR) {
-				struct vec4 color_from;
-				vec4_from_rgba(&color_from,
-					       (uint32_t)obs_data_get_int(
-						       item, S_SETTING_FROM));
-				gs_float3_srgb_nonlinear_to_linear(
-					color_from.ptr);
-				struct vec4 color_to;
-				vec4_from_rgba(&color_to,
-					       (uint32_t)obs_data_get_int(
-						       item, S_SETTING_TO));
-				gs_float3_srgb_nonlinear_to_linear(
-					color_to.ptr);
-				struct vec4 color;
-				color.w = (1.0f - t) * color_from.w +
-					  t * color_to.w;
-				color.x = (1.0f - t) * color_from.x +
-					  t * color_to.x;
-				color.y = (1.0f - t) * color_from.y +
-					  t * color_to.y;
-				color.z = (1.0f - t) * color_from.z +
-					  t * color_to.z;
-				gs_float3_srgb_linear_to_nonlinear(color.ptr);
-				const long long value_int =
-					vec4_to_rgba(&color);
-				obs_data_set_int(ss, setting_name, value_int);
+					(long long)move_value_lerp(
+						setting->from, setting->to, t);
+				update |= move_value_set_int(ss, setting->name,
+							     value_int,
+							     &setting->last);
+			} else if (setting->value_type == MOVE_VALUE_FLOAT) {
+				const double value_double = move_value_lerp(
+					setting->from, setting->to, t);
+				update |= move_value_set_double(
+					ss, setting->name, value_double,
+					moving ? setting->step : 0.0,
+					&setting->last);
+			} else {
+				update |= move_value_set_int(
+					ss, setting->name,
+					move_value->color_values
+						.array[setting->color],
+					&setting->last);
 			}
 		}
 	} else if (move_value->value_type == MOVE_VALUE_INT) {
-		const long long value_int =
-			(long long)((1.0 - t) * (double)move_value->int_from +
-				    t * (double)move_value->int_to);
-		if (strcmp(move_value->setting_name, VOLUME_SETTING) == 0) {
+		const long long value_int = (long long)move_value_lerp(
+			(double)move_value->int_from,
+			(double)move_value->int_to, t);
+		if (move_value->setting_kind == MOVE_VALUE_KIND_VOLUME) {
 			obs_source_set_volume(source,
 					      (float)value_int / 100.0f);
-			update = false;
-		} else if (strcmp(move_value->setting_name, BALANCE_SETTING) ==
-			   0) {
+		} else if (move_value->setting_kind ==
+			   MOVE_VALUE_KIND_BALANCE) {
 			obs_source_set_balance_value(source,
 						     (float)value_int / 100.0f);
-			update = false;
 		} else {
-			obs_data_set_int(ss, move_value->setting_name,
-					 value_int);
+			update |= move_value_set_int(ss,
+						     move_value->setting_name,
+						     value_int,
+						     &move_value->value_last);
 		}
 	} else if (move_value->value_type == MOVE_VALUE_FLOAT) {
-		const double value_double =
-			(1.0 - t) * move_value->double_from +
-			t * move_value->double_to;
-		if (strcmp(move_value->setting_name, VOLUME_SETTING) == 0) {
+		const double value_double = move_value_lerp(
+			move_value->double_from, move_value->double_to, t);
+		if (move_value->setting_kind == MOVE_VALUE_KIND_VOLUME) {
 			obs_source_set_volume(source,
 					      (float)(value_double / 100.0));
-			update = false;
-		} else if (strcmp(move_value->setting_name, BALANCE_SETTING) ==
-			   0) {
+		} else if (move_value->setting_kind ==
+			   MOVE_VALUE_KIND_BALANCE) {
 			obs_source_set_balance_value(
 				source, (float)(value_double / 100.0));
-			update = false;
 		} else {
-			obs_data_set_double(ss, move_value->setting_name,
-					    value_double);
+			update |= move_value_set_double(
+				ss, move_value->setting_name, value_double,
+				moving ? move_value->double_step : 0.0,
+				&move_value->value_last);
 		}
 	} else if (move_value->value_type == MOVE_VALUE_COLOR) {
-		struct vec4 color;
-		color.w = (1.0f - t) * move_value->color_from.w +
-			  t * move_value->color_to.w;
-		color.x = (1.0f - t) * move_value->color_from.x +
-			  t * move_value->color_to.x;
-		color.y = (1.0f - t) * move_value->color_from.y +
-			  t * move_value->color_to.y;
-		color.z = (1.0f - t) * move_value->color_from.z +
-			  t * move_value->color_to.z;
-		gs_float3_srgb_linear_to_nonlinear(color.ptr);
-		const long long value_int = vec4_to_rgba(&color);
-		obs_data_set_int(ss, move_value->setting_name, value_int);
+		uint32_t value_int;
+		move_color_lerp_batch(&move_value->color_track, 1, t,
+				      move_value->color_space, &value_int);
+		update |= move_value_set_int(ss, move_value->setting_name,
+					     value_int,
+					     &move_value->value_last);
 	} else if (move_value->value_type == MOVE_VALUE_TEXT &&
 		   move_value->move_value_type == MOVE_VALUE_TYPE_TYPING) {
-		if (t * move_value->text_steps <= move_value->text_step &&
-		    move_value->move_filter.moving) {
-			obs_data_release(ss);
-			return;
-		}
-		move_value->text_step =
-			(size_t)(t * (float)move_value->text_steps);
-		char *text = NULL;
-		if (move_value->text_step <
-		    move_value->text_from_len - move_value->text_same) {
-			text = bstrdup_n(move_value->text_from,
-					 move_value->text_from_len -
-						 move_value->text_step);
-		} else {
-			text = bstrdup_n(move_value->text_to,
-					 move_value->text_same +
-						 move_value->text_step -
-						 (move_value->text_from_len -
-						  move_value->text_same));
+		const size_t step = move_typing_step(
+			&move_value->typing, t, move_value->text_step,
+			move_value->typing_step,
+			move_value->move_filter.reverse, moving);
+		/* step 0 is the text the move started from */
+		if (move_value->text_buffer && step != move_value->text_step) {
+			move_value->text_step = step;
+			const char *src;
+			const size_t len = move_typing_text(
+				&move_value->typing, step, &src);
+			memcpy(move_value->text_buffer, src, len);
+			move_value->text_buffer[len] = '\0';
+			obs_data_set_string(ss, move_value->setting_name,
+					    move_value->text_buffer);
+			update = true;
 		}
-		obs_data_set_string(ss, move_value->setting_name, text);
-		bfree(text);
 	} else if (move_value->value_type == MOVE_VALUE_TEXT) {
-		double value_double = (1.0 - t) * move_value->double_from +
-				      t * move_value->double_to;
 		char text[TEXT_BUFFER_SIZE];
-		if (move_value->format_type == MOVE_VALUE_FORMAT_FLOAT) {
-			if (snprintf(text, TEXT_BUFFER_SIZE, move_value->format,
-				     value_double) == 0)
-				text[0] = '\0';
-
-		} else if (move_value->format_type == MOVE_VALUE_FORMAT_TIME) {
-			long long t = (long long)value_double;
-			struct tm *tm_info = gmtime((const time_t *)&t);
-			if (strftime(text, TEXT_BUFFER_SIZE, move_value->format,
-				     tm_info) == 0)
-				text[0] = '\0';
-		} else {
-			if (move_value->decimals >= 0) {
-				char format[20];
-				snprintf(format, 20, "%%.%df",
-					 move_value->decimals);
-				snprintf(text, TEXT_BUFFER_SIZE, format,
-					 value_double);
-			} else {
-				double factor = pow(
-					10,
-					-1.0 * (double)move_value->decimals);
-				value_double =
-					floor(value_double / factor) * factor;
-				snprintf(text, TEXT_BUFFER_SIZE, "%.0f",
-					 value_double);
-			}
+		move_value_format(text, TEXT_BUFFER_SIZE,
+				  move_value->format_type, move_value->format,
+				  move_value->decimals,
+				  move_value_lerp(move_value->double_from,
+						  move_value->double_to, t));
+		if (!move_value->text_last_set ||
+		    strcmp(move_value->text_last, text) != 0) {
+			obs_data_set_string(ss, move_value->setting_name, text);
+			strcpy(move_value->text_last, text);
+			move_value->text_last_set = true;
+			update = true;
 		}
-		obs_data_set_string(ss, move_value->setting_name, text);
 	} else {
-		obs_data_item_t *item =
-			obs_data_item_byname(ss, move_value->setting_name);
-		const enum obs_data_number_type item_type =
-			obs_data_item_numtype(item);
-		if (item_type == OBS_DATA_NUM_INT) {
-			const long long value_int =
-				(long long)((1.0 -
-					     t) * (double)move_value->int_from +
-					    t * (double)move_value->int_to);
-			if (strcmp(move_value->setting_name, VOLUME_SETTING) ==
-			    0) {
+		if (move_value->number_type == OBS_DATA_NUM_INT) {
+			const long long value_int = (long long)move_value_lerp(
+				(double)move_value->int_from,
+				(double)move_value->int_to, t);
+			if (move_value->setting_kind ==
+			    MOVE_VALUE_KIND_VOLUME) {
 				obs_source_set_volume(source, (float)value_int /
 								      100.0f);
-				update = false;
-			} else if (strcmp(move_value->setting_name,
-					  BALANCE_SETTING) == 0) {
+			} else if (move_value->setting_kind ==
+				   MOVE_VALUE_KIND_BALANCE) {
 				obs_source_set_balance_value(
 					source, (float)value_int / 100.0f);
-				update = false;
 			} else {
-				obs_data_set_int(ss, move_value->setting_name,
-						 value_int);
+				update |= move_value_set_int(
+					ss, move_value->setting_name,
+					value_int, &move_value->value_last);
 			}
-		} else if (item_type == OBS_DATA_NUM_DOUBLE) {
+		} else if (move_value->number_type == OBS_DATA_NUM_DOUBLE) {
 			const double value_double =
-				(1.0 - t) * move_value->double_from +
-				t * move_value->double_to;
-			if (strcmp(move_value->setting_name, VOLUME_SETTING) ==
-			    0) {
+				move_value_lerp(move_value->double_from,
+						move_value->double_to, t);
+			if (move_value->setting_kind ==
+			    MOVE_VALUE_KIND_VOLUME) {
 				obs_source_set_volume(
 					source, (float)value_double / 100.0f);
-				update = false;
-			} else if (strcmp(move_value->setting_name,
-					  BALANCE_SETTING) == 0) {
+			} else if (move_value->setting_kind ==
+				   MOVE_VALUE_KIND_BALANCE) {
 				obs_source_set_balance_value(
 					source, (float)value_double / 100.0f);
-				update = false;
 			} else {
-				obs_data_set_double(ss,
-						    move_value->setting_name,
-						    value_double);
+				update |= move_value_set_double(
+					ss, move_value->setting_name,
+					value_double,
+					moving ? move_value->double_step : 0.0,
+					&move_value->value_last);
 			}
 		}
-		obs_data_item_release(&item);
 	}
-	obs_data_release(ss);
-	if (update)
-		obs_source_update(source, NULL);
+	if (!held)
+		obs_data_release(ss);
+	move_value_target_tick(move_value, source, update);
 	if (!move_value->move_filter.moving) {
+		move_value_target_leave(move_value, true);
+		move_value_drop_move_target(move_value);
 		move_filter_ended(&move_value->move_filter);
 	}
 }
@@ -0,0 +1,312 @@
+#include "move-value.h"
+#include <float.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+double move_value_lerp(double from, double to, float t)
+{
+	return (1.0 - t) * from + t * to;
+}
+
+long long rand_between(long long a, long long b)
+{
+	return b > a ? a + rand() % (b - a) : b + rand() % (a - b);
+}
+
+float rand_between_float(float a, float b)
+{
+	return b > a ? a + (b - a) * (float)rand() / (float)RAND_MAX
+		     : b + (a - b) * (float)rand() / (float)RAND_MAX;
+}
+double rand_between_double(double a, double b)
+{
+	return b > a ? a + (b - a) * (double)rand() / (double)RAND_MAX
+		     : b + (a - b) * (double)rand() / (double)RAND_MAX;
+}
+
+size_t move_value_utf8_chars(const char *text, size_t len)
+{
+	size_t chars = 0;
+	for (size_t i = 0; i < len; i++) {
+		if ((text[i] & 0xC0) != 0x80)
+			chars++;
+	}
+	return chars;
+}
+
+size_t move_value_utf8_offset(const char *text, size_t len, size_t chars)
+{
+	size_t i = 0;
+	while (i < len && chars) {
+		i++;
+		while (i < len && (text[i] & 0xC0) == 0x80)
+			i++;
+		chars--;
+	}
+	return i;
+}
+
+void move_typing_init(struct move_typing *typing, const char *from,
+		      const char *to)
+{
+	typing->from = from;
+	typing->from_len = strlen(from);
+	typing->from_chars = move_value_utf8_chars(from, typing->from_len);
+	typing->to = to;
+	typing->to_len = strlen(to);
+	typing->to_chars = move_value_utf8_chars(to, typing->to_len);
+
+	size_t same = 0;
+	while (same < typing->from_len && same < typing->to_len &&
+	       from[same] == to[same])
+		same++;
+	/* do not split a multibyte character */
+	while (same && ((same < typing->from_len &&
+			 (from[same] & 0xC0) == 0x80) ||
+			(same < typing->to_len && (to[same] & 0xC0) == 0x80)))
+		same--;
+	typing->same = same;
+	typing->same_chars = move_value_utf8_chars(from, same);
+	typing->steps = (typing->from_chars - typing->same_chars) +
+			(typing->to_chars - typing->same_chars);
+}
+
+size_t move_typing_step(const struct move_typing *typing, float t,
+			size_t step, long long chars_per_tick, bool reverse,
+			bool moving)
+{
+	if (!moving)
+		return reverse ? 0 : typing->steps;
+	if (chars_per_tick <= 0) {
+		/* easing can overshoot either end */
+		if (t <= 0.0f)
+			return 0;
+		if (t >= 1.0f)
+			return typing->steps;
+		return (size_t)(t * (float)typing->steps);
+	}
+	const size_t chars = (size_t)chars_per_tick;
+	if (step > typing->steps)
+		step = typing->steps;
+	if (reverse)
+		return step > chars ? step - chars : 0;
+	return typing->steps - step > chars ? step + chars : typing->steps;
+}
+
+size_t move_typing_text(const struct move_typing *typing, size_t step,
+			const char **text)
+{
+	const size_t erase_steps = typing->from_chars - typing->same_chars;
+	if (step < erase_steps) {
+		*text = typing->from;
+		return move_value_utf8_offset(typing->from, typing->from_len,
+					      typing->from_chars - step);
+	}
+	*text = typing->to;
+	return move_value_utf8_offset(typing->to, typing->to_len,
+				      typing->same_chars + step - erase_steps);
+}
+
+static const double move_value_pow10[] = {
+	1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,
+	1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18,
+};
+
+#define MOVE_VALUE_POW10_MAX 18
+
+/* same output as "%.<decimals>f" without going through printf, returns false
+ * when the value does not fit the fast path */
+static bool move_value_format_fixed(char *text, size_t size, double value,
+				    int decimals)
+{
+	if (decimals < 0 || decimals > MOVE_VALUE_POW10_MAX || !isfinite(value))
+		return false;
+	const double scaled = fabs(value) * move_value_pow10[decimals];
+	if (scaled >= 1e15)
+		return false;
+	unsigned long long v = (unsigned long long)scaled;
+	const double frac = scaled - (double)v;
+	/* too close to a tie to round the same way printf does */
+	if (fabs(frac - 0.5) <= scaled * 4.0 * DBL_EPSILON)
+		return false;
+	if (frac > 0.5)
+		v++;
+	const bool negative = signbit(value);
+
+	char digits[48];
+	char *end = digits + sizeof(digits);
+	char *pos = end;
+	int d = 0;
+	do {
+		if (decimals && d == decimals)
+			*--pos = '.';
+		*--pos = (char)('0' + v % 10);
+		v /= 10;
+		d++;
+	} while (v || d <= decimals);
+	if (negative)
+		*--pos = '-';
+
+	const size_t len = (size_t)(end - pos);
+	if (len >= size)
+		return false;
+	memcpy(text, pos, len);
+	text[len] = '\0';
+	return true;
+}
+
+static bool move_value_append_2digits(char *text, size_t size, size_t *len,
+				      int value)
+{
+	if (*len + 2 >= size)
+		return false;
+	text[(*len)++] = (char)('0' + value / 10);
+	text[(*len)++] = (char)('0' + value % 10);
+	return true;
+}
+
+/* strftime for a duration in seconds, only handles the fixed time of day
+ * conversions so callers fall back to strftime for anything else, like the
+ * locale dependent %X */
+static bool move_value_format_time(char *text, size_t size, const char *format,
+				   long long seconds)
+{
+	long long day = seconds % 86400;
+	if (day < 0)
+		day += 86400;
+	const int hour = (int)(day / 3600);
+	const int min = (int)(day / 60 % 60);
+	const int sec = (int)(day % 60);
+
+	size_t len = 0;
+	for (const char *f = format; *f; f++) {
+		if (*f != '%') {
+			if (len + 1 >= size)
+				return false;
+			text[len++] = *f;
+			continue;
+		}
+		f++;
+		bool ok = true;
+		switch (*f) {
+		case 'H':
+			ok = move_value_append_2digits(text, size, &len, hour);
+			break;
+		case 'M':
+			ok = move_value_append_2digits(text, size, &len, min);
+			break;
+		case 'S':
+			ok = move_value_append_2digits(text, size, &len, sec);
+			break;
+		case 'T':
+		case 'R':
+			ok = move_value_append_2digits(text, size, &len,
+						       hour) &&
+			     len + 1 < size;
+			if (ok) {
+				text[len++] = ':';
+				ok = move_value_append_2digits(text, size, &len,
+							       min);
+			}
+			if (ok && *f != 'R') {
+				ok = len + 1 < size;
+				if (ok) {
+					text[len++] = ':';
+					ok = move_value_append_2digits(
+						text, size, &len, sec);
+				}
+			}
+			break;
+		case '%':
+		case 'n':
+		case 't':
+			ok = len + 1 < size;
+			if (ok)
+				text[len++] = *f == 'n'   ? '\n'
+					      : *f == 't' ? '\t'
+							  : '%';
+			break;
+		default:
+			return false;
+		}
+		if (!ok)
+			return false;
+	}
+	text[len] = '\0';
+	return true;
+}
+
+void move_value_format(char *text, size_t size, long long format_type,
+		       const char *format, int decimals, double value)
+{
+	if (format_type == MOVE_VALUE_FORMAT_FLOAT) {
+		if (snprintf(text, size, format, value) == 0)
+			text[0] = '\0';
+
+	} else if (format_type == MOVE_VALUE_FORMAT_TIME) {
+		long long t = (long long)value;
+		if (!move_value_format_time(text, size, format, t)) {
+			struct tm *tm_info = gmtime((const time_t *)&t);
+			if (strftime(text, size, format, tm_info) == 0)
+				text[0] = '\0';
+		}
+	} else if (decimals >= 0) {
+		if (!move_value_format_fixed(text, size, value, decimals))
+			snprintf(text, size, "%.*f", decimals, value);
+	} else {
+		const int exponent = -decimals;
+		const double factor = exponent <= MOVE_VALUE_POW10_MAX
+					      ? move_value_pow10[exponent]
+					      : pow(10, (double)exponent);
+		value = floor(value / factor) * factor;
+		if (!move_value_format_fixed(text, size, value, 0))
+			snprintf(text, size, "%.0f", value);
+	}
+}
+
+double move_value_parse(long long format_type, const char *format,
+			const char *text)
+{
+	double value = 0.0;
+	if (format_type == MOVE_VALUE_FORMAT_FLOAT) {
+
+		sscanf(text, format, &value);
+	} else if (format_type == MOVE_VALUE_FORMAT_TIME) {
+		char *pos;
+		unsigned int sec = 0;
+		unsigned int min = 0;
+		unsigned int hour = 0;
+		if (((pos = strstr(format, "%X"))) ||
+		    ((pos = strstr(format, "%H:%M:%S")))) {
+			if ((size_t)(pos - format) < strlen(text))
+				sscanf(text + (pos - format), "%u:%u:%u", &hour,
+				       &min, &sec);
+		} else if (((pos = strstr(format, "%R"))) ||
+			   ((pos = strstr(format, "%H:%M")))) {
+			if ((size_t)(pos - format) < strlen(text))
+				sscanf(text + (pos - format), "%u:%u", &hour,
+				       &min);
+		} else if ((pos = strstr(format, "%M:%S"))) {
+			if ((size_t)(pos - format) < strlen(text))
+				sscanf(text + (pos - format), "%u:%u", &min,
+				       &sec);
+		} else {
+			if ((pos = strstr(format, "%S"))) {
+				sscanf(text + (pos - format), "%u", &sec);
+			}
+			if ((pos = strstr(format, "%M"))) {
+				sscanf(text + (pos - format), "%u", &min);
+			}
+			if ((pos = strstr(format, "%H"))) {
+				sscanf(text + (pos - format), "%u", &hour);
+			}
+		}
+		value = hour * 3600 + min * 60 + sec;
+	} else {
+		value = strtod(text, NULL);
+	}
+	return value;
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+/* Value interpolation, typing and text formatting of the move value filter,
+ * shared with the headless move-eval tool. Nothing in here may depend on
+ * libobs. */
+
+#include "move-timeline.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MOVE_VALUE_UNKNOWN 0
+#define MOVE_VALUE_INT 1
+#define MOVE_VALUE_FLOAT 2
+#define MOVE_VALUE_COLOR 3
+#define MOVE_VALUE_TEXT 4
+
+#define MOVE_VALUE_FORMAT_DECIMALS 0
+#define MOVE_VALUE_FORMAT_FLOAT 1
+#define MOVE_VALUE_FORMAT_TIME 2
+
+#define MOVE_VALUE_TYPE_SINGLE_SETTING 0
+#define MOVE_VALUE_TYPE_SETTINGS 1
+#define MOVE_VALUE_TYPE_RANDOM 2
+#define MOVE_VALUE_TYPE_SETTING_ADD 3
+#define MOVE_VALUE_TYPE_TYPING 4
+
+double move_value_lerp(double from, double to, float t);
+
+long long rand_between(long long a, long long b);
+float rand_between_float(float a, float b);
+double rand_between_double(double a, double b);
+
+size_t move_value_utf8_chars(const char *text, size_t len);
+/* byte length of the first chars characters of text */
+size_t move_value_utf8_offset(const char *text, size_t len, size_t chars);
+
+/* Typing from one text to another first erases the characters of from
+ * after the part both start with, then types the rest of to, a character
+ * per step. The texts are not copied. */
+struct move_typing {
+	const char *from;
+	size_t from_len;
+	size_t from_chars;
+	const char *to;
+	size_t to_len;
+	size_t to_chars;
+	size_t same;
+	size_t same_chars;
+	size_t steps;
+};
+
+void move_typing_init(struct move_typing *typing, const char *from,
+		      const char *to);
+/* Step to show this tick. Follows the eased progress t, or with
+ * chars_per_tick set moves on from the previous step by that many
+ * characters each tick. A move that is done jumps to its end. */
+size_t move_typing_step(const struct move_typing *typing, float t,
+			size_t step, long long chars_per_tick, bool reverse,
+			bool moving);
+/* the text shown at step is the returned number of bytes at *text */
+size_t move_typing_text(const struct move_typing *typing, size_t step,
+			const char **text);
+
+/* formats value for a text setting: with decimals, negative decimals round
+ * down to tens, hundreds and so on, or with a printf or strftime format */
+void move_value_format(char *text, size_t size, long long format_type,
+		       const char *format, int decimals, double value);
+/* reads back a value written by move_value_format */
+double move_value_parse(long long format_type, const char *format,
+			const char *text);
+
+#ifdef __cplusplus
+}
+#endif